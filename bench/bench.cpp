@@ -0,0 +1,824 @@
+#include "batch_solver.hpp"
+#include "bit_flood.hpp"
+#include "component_index.hpp"
+#include "distance_field.hpp"
+#include "generator.hpp"
+#include "grid.hpp"
+#include "hierarchy.hpp"
+#include "jump_table.hpp"
+#include "landmarks.hpp"
+#include "map_loader.hpp"
+#include "replanner.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+
+struct Workload
+{
+    std::string suite;
+    std::string name;
+    Grid grid;
+    std::vector<Query> queries;
+};
+
+
+struct Configuration
+{
+    std::string name;
+    SearchOptions options;
+    bool hierarchical = false;
+    bool landmarks = false;
+    bool components = false;
+};
+
+
+struct Settings
+{
+    int size = 512;
+    int queries = 200;
+    std::uint32_t seed = 1;
+    bool csv = false;
+    bool replan = false;
+    bool flood = false;
+    bool field = false;
+    std::vector<std::string> scenarios;
+    std::string maps;
+    std::string landmarks;
+};
+
+
+// Reads a "Vm..." line of /proc/self/status, -1 where there is none.
+[[nodiscard]] static long statusKiB(const std::string &field)
+{
+    std::ifstream status("/proc/self/status");
+
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.starts_with(field))
+        {
+            return std::stol(line.substr(field.size()));
+        }
+    }
+
+    return -1;
+}
+
+
+// Starts a new peak measurement and returns the resident memory it is relative to. Only Linux lets
+// a process reset its high water mark, elsewhere this returns -1.
+[[nodiscard]] static long resetPeakMemory()
+{
+#if defined(__linux__)
+#if defined(__GLIBC__)
+    // Memory the previous configuration freed would otherwise stay resident and hide this one's.
+    malloc_trim(0);
+#endif
+
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    clear_refs.close();
+
+    if (clear_refs)
+    {
+        return statusKiB("VmRSS:");
+    }
+#endif
+
+    return -1;
+}
+
+
+// What the measurement added to the resident memory at its peak. Without a baseline ru_maxrss is
+// all there is, which only grows and holds the peak of the whole process.
+[[nodiscard]] static long peakMemoryKiB(const long baseline)
+{
+    if (baseline >= 0)
+    {
+        const long peak = statusKiB("VmHWM:");
+        if (peak >= 0)
+        {
+            return std::max(peak - baseline, 0L);
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+
+[[nodiscard]] static std::vector<Query> randomQueries(const Grid &grid, const int count, const std::uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution distribution_x(0, grid.width() - 1);
+    std::uniform_int_distribution distribution_y(0, grid.height() - 1);
+
+    std::vector<Query> queries;
+    int attempts = 0;
+
+    while (static_cast<int>(queries.size()) < count && attempts++ < count * 1000)
+    {
+        const glm::ivec2 start(distribution_x(generator), distribution_y(generator));
+        const glm::ivec2 goal(distribution_x(generator), distribution_y(generator));
+
+        if (!grid.blocked(start) && !grid.blocked(goal))
+        {
+            queries.push_back({start, goal});
+        }
+    }
+
+    return queries;
+}
+
+
+[[nodiscard]] static std::vector<Workload> syntheticWorkloads(const Settings &settings)
+{
+    std::vector<Workload> workloads;
+
+    for (const int density : {10, 20, 30, 40})
+    {
+        Grid grid(settings.size, settings.size);
+        fillNoise(grid, density, settings.seed);
+
+        std::vector<Query> queries = randomQueries(grid, settings.queries, settings.seed + 1);
+        workloads.push_back({"noise", "noise-" + std::to_string(density), std::move(grid), std::move(queries)});
+    }
+
+    {
+        Grid grid(settings.size, settings.size);
+        fillNoise(grid, 20, settings.seed);
+        fillTerrain(grid, 8, settings.seed);
+
+        std::vector<Query> queries = randomQueries(grid, settings.queries, settings.seed + 1);
+        workloads.push_back({"terrain", "terrain-20", std::move(grid), std::move(queries)});
+    }
+
+    // Costs up to 255 drive f far above the heuristic, the range a bucket queue has to cover.
+    {
+        Grid grid(settings.size, settings.size);
+        fillNoise(grid, 20, settings.seed);
+        fillTerrain(grid, 255, settings.seed);
+
+        std::vector<Query> queries = randomQueries(grid, settings.queries, settings.seed + 1);
+        workloads.push_back({"terrain", "terrain-20-heavy", std::move(grid), std::move(queries)});
+    }
+
+    {
+        Grid grid = generateMaze(settings.size - 1, settings.size - 1, settings.seed);
+        std::vector<Query> queries = randomQueries(grid, settings.queries, settings.seed + 1);
+        workloads.push_back({"maze", "maze", std::move(grid), std::move(queries)});
+    }
+
+    for (const int room_size : {16, 64})
+    {
+        Grid grid = generateRooms(settings.size, settings.size, room_size, settings.seed);
+        std::vector<Query> queries = randomQueries(grid, settings.queries, settings.seed + 1);
+        workloads.push_back({"rooms", "rooms-" + std::to_string(room_size), std::move(grid), std::move(queries)});
+    }
+
+    return workloads;
+}
+
+
+[[nodiscard]] static std::vector<Workload> scenarioWorkloads(const Settings &settings)
+{
+    std::vector<Workload> workloads;
+
+    for (const std::string &path : settings.scenarios)
+    {
+        const std::optional<std::vector<Scenario>> scenarios = loadMovingAIScenario(path);
+        if (!scenarios)
+        {
+            continue;
+        }
+
+        const std::filesystem::path map_directory = settings.maps.empty() ?
+            std::filesystem::path(path).parent_path() :
+            std::filesystem::path(settings.maps);
+
+        std::map<std::string, std::vector<Query>> queries_by_map;
+        for (const Scenario &scenario : *scenarios)
+        {
+            queries_by_map[scenario.map].push_back({scenario.start, scenario.goal});
+        }
+
+        for (auto &[map, queries] : queries_by_map)
+        {
+            std::optional<Grid> grid = loadMovingAIMap((map_directory / map).string());
+            if (!grid)
+            {
+                grid = loadMovingAIMap((map_directory / std::filesystem::path(map).filename()).string());
+            }
+            if (!grid)
+            {
+                continue;
+            }
+
+            workloads.push_back({"movingai", std::filesystem::path(map).stem().string(), std::move(*grid), std::move(queries)});
+        }
+    }
+
+    return workloads;
+}
+
+
+[[nodiscard]] static std::int64_t percentile(const std::vector<std::int64_t> &sorted, const double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    const auto position = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(position, sorted.size() - 1)];
+}
+
+
+// Loads the map's landmark tables from the cache directory if there is one, building and storing them otherwise.
+static void prepareLandmarks(Landmarks &landmarks, const Workload &workload, const Settings &settings)
+{
+    std::filesystem::path path;
+    if (!settings.landmarks.empty())
+    {
+        path = std::filesystem::path(settings.landmarks) / (workload.suite + "-" + workload.name + ".alt");
+        if (std::filesystem::exists(path) && landmarks.load(path.string()))
+        {
+            return;
+        }
+    }
+
+    landmarks.build();
+
+    if (!path.empty())
+    {
+        static_cast<void>(landmarks.save(path.string()));
+    }
+}
+
+
+static void run(Workload &workload, const Configuration &configuration, const Settings &settings)
+{
+    // Preprocessing counts towards the configuration's memory, the pregenerated workloads do not.
+    const long memory_baseline = resetPeakMemory();
+
+    SearchOptions options = configuration.options;
+
+    // Like the abstraction below, the tables are preprocessing and not part of the query latency.
+    // Only JPS+ reads the jump table, the other modes must not be charged for its memory.
+    std::optional<JumpTable> jump_table;
+    if (options.mode == SearchMode::JPS_PLUS)
+    {
+        jump_table.emplace(workload.grid);
+        jump_table->update();
+        options.jump_table = &*jump_table;
+    }
+
+    std::optional<Landmarks> landmarks;
+    if (configuration.landmarks)
+    {
+        landmarks.emplace(workload.grid);
+        prepareLandmarks(*landmarks, workload, settings);
+        options.landmarks = &*landmarks;
+    }
+
+    std::optional<ComponentIndex> components;
+    if (configuration.components)
+    {
+        components.emplace(workload.grid);
+        components->rebuild();
+        options.components = &*components;
+    }
+
+    Search search(options);
+
+    // The abstraction is built once per map, queries only pay for the abstract search and refinement.
+    std::optional<Hierarchy> hierarchy;
+    if (configuration.hierarchical)
+    {
+        hierarchy.emplace(workload.grid);
+    }
+
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(workload.queries.size());
+
+    std::uint64_t expansions = 0;
+    std::uint64_t generated = 0;
+    std::uint64_t peak_open = 0;
+    std::size_t found = 0;
+    std::int64_t total_ns = 0;
+
+    for (const Query &query : workload.queries)
+    {
+        const auto start_time = std::chrono::steady_clock::now();
+        const PathResult result = hierarchy ?
+            hierarchy->findPath(query.start, query.goal) :
+            search.findPath(workload.grid, query.start, query.goal);
+        const auto end_time = std::chrono::steady_clock::now();
+
+        const std::int64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+        latencies.push_back(latency);
+        total_ns += latency;
+
+        expansions += result.expanded;
+        generated += result.stats.generated;
+        peak_open = std::max(peak_open, result.stats.peak_open);
+        found += result.found;
+    }
+
+    const long peak_memory = peakMemoryKiB(memory_baseline);
+
+    std::ranges::sort(latencies);
+
+    const std::size_t query_count = workload.queries.size();
+    const double seconds = static_cast<double>(total_ns) * 1e-9;
+    const double ns_per_query = query_count > 0 ? static_cast<double>(total_ns) / static_cast<double>(query_count) : 0.0;
+    const double expansions_per_second = seconds > 0.0 ? static_cast<double>(expansions) / seconds : 0.0;
+
+    if (settings.csv)
+    {
+        std::cout <<
+            workload.suite << "," <<
+            workload.name << "," <<
+            workload.grid.width() << "x" << workload.grid.height() << "," <<
+            configuration.name << "," <<
+            query_count << "," <<
+            found << "," <<
+            expansions << "," <<
+            generated << "," <<
+            peak_open << "," <<
+            static_cast<std::uint64_t>(expansions_per_second) << "," <<
+            static_cast<std::uint64_t>(ns_per_query) << "," <<
+            percentile(latencies, 0.5) << "," <<
+            percentile(latencies, 0.99) << "," <<
+            peak_memory << "\n";
+    }
+    else
+    {
+        std::cout <<
+            "{\"suite\":\"" << workload.suite << "\"" <<
+            ",\"map\":\"" << workload.name << "\"" <<
+            ",\"size\":\"" << workload.grid.width() << "x" << workload.grid.height() << "\"" <<
+            ",\"config\":\"" << configuration.name << "\"" <<
+            ",\"queries\":" << query_count <<
+            ",\"found\":" << found <<
+            ",\"expansions\":" << expansions <<
+            ",\"generated\":" << generated <<
+            ",\"peak_open\":" << peak_open <<
+            ",\"expansions_per_sec\":" << static_cast<std::uint64_t>(expansions_per_second) <<
+            ",\"ns_per_query\":" << static_cast<std::uint64_t>(ns_per_query) <<
+            ",\"p50_ns\":" << percentile(latencies, 0.5) <<
+            ",\"p99_ns\":" << percentile(latencies, 0.99) <<
+            ",\"peak_memory_kib\":" << peak_memory << "}\n";
+    }
+}
+
+
+// Plans every query with D* Lite, blocks a few tiles along the path and compares the repair
+// with planning from scratch on the edited map.
+static void runReplanning(Workload &workload, const Settings &settings)
+{
+    constexpr std::size_t EDITS_PER_QUERY = 5;
+
+    std::uint64_t replan_expanded = 0;
+    std::uint64_t full_expanded = 0;
+    std::int64_t replan_ns = 0;
+    std::int64_t full_ns = 0;
+    std::size_t planned = 0;
+
+    for (const Query &query : workload.queries)
+    {
+        std::vector<glm::ivec2> edits;
+
+        {
+            Replanner replanner(workload.grid);
+            replanner.begin(query.start, query.goal);
+
+            const PathResult initial = replanner.plan();
+            if (!initial.found || initial.path.size() < 3)
+            {
+                continue;
+            }
+
+            for (std::size_t i = 1; i <= EDITS_PER_QUERY; i++)
+            {
+                edits.push_back(initial.path[i * (initial.path.size() - 1) / (EDITS_PER_QUERY + 1)]);
+            }
+            for (const glm::ivec2 &position : edits)
+            {
+                if (position != query.start && position != query.goal)
+                {
+                    workload.grid.block(position);
+                }
+            }
+
+            const auto replan_start = std::chrono::steady_clock::now();
+            static_cast<void>(replanner.plan());
+            replan_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - replan_start).count();
+            replan_expanded += replanner.stats().expanded;
+        }
+
+        {
+            Replanner replanner(workload.grid);
+            replanner.begin(query.start, query.goal);
+
+            const auto full_start = std::chrono::steady_clock::now();
+            static_cast<void>(replanner.plan());
+            full_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - full_start).count();
+            full_expanded += replanner.stats().expanded;
+        }
+
+        for (const glm::ivec2 &position : edits)
+        {
+            if (position != query.start && position != query.goal)
+            {
+                workload.grid.unblock(position);
+            }
+        }
+
+        planned++;
+    }
+
+    if (settings.csv)
+    {
+        std::cout <<
+            workload.suite << "," <<
+            workload.name << "," <<
+            workload.grid.width() << "x" << workload.grid.height() << "," <<
+            planned << "," <<
+            EDITS_PER_QUERY << "," <<
+            replan_expanded << "," <<
+            full_expanded << "," <<
+            replan_ns << "," <<
+            full_ns << "\n";
+    }
+    else
+    {
+        std::cout <<
+            "{\"suite\":\"" << workload.suite << "\"" <<
+            ",\"map\":\"" << workload.name << "\"" <<
+            ",\"size\":\"" << workload.grid.width() << "x" << workload.grid.height() << "\"" <<
+            ",\"config\":\"dstar-lite\"" <<
+            ",\"queries\":" << planned <<
+            ",\"edits_per_query\":" << EDITS_PER_QUERY <<
+            ",\"replan_expanded\":" << replan_expanded <<
+            ",\"full_expanded\":" << full_expanded <<
+            ",\"replan_ns\":" << replan_ns <<
+            ",\"full_ns\":" << full_ns << "}\n";
+    }
+}
+
+
+// Answers every query with the word parallel flood and with A*, the step counts have to agree.
+// Terrain maps are skipped, the flood only counts steps.
+static void runFlood(Workload &workload, const Settings &settings)
+{
+    if (!workload.grid.uniformCost())
+    {
+        return;
+    }
+
+    BitFlood flood(workload.grid);
+    Search search;
+
+    std::int64_t flood_ns = 0;
+    std::int64_t search_ns = 0;
+    std::size_t mismatches = 0;
+
+    for (const Query &query : workload.queries)
+    {
+        const auto flood_start = std::chrono::steady_clock::now();
+        const unsigned int steps = flood.distance(query.start, query.goal);
+        const auto search_start = std::chrono::steady_clock::now();
+        const PathResult result = search.findPath(workload.grid, query.start, query.goal);
+        const auto search_end = std::chrono::steady_clock::now();
+
+        flood_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(search_start - flood_start).count();
+        search_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(search_end - search_start).count();
+
+        const unsigned int expected = result.found ? result.cost / workload.grid.minimumCost() : BitFlood::UNREACHED;
+        mismatches += steps != expected;
+    }
+
+    const std::size_t query_count = workload.queries.size();
+    const std::int64_t flood_per_query = query_count > 0 ? flood_ns / static_cast<std::int64_t>(query_count) : 0;
+    const std::int64_t search_per_query = query_count > 0 ? search_ns / static_cast<std::int64_t>(query_count) : 0;
+
+    if (settings.csv)
+    {
+        std::cout <<
+            workload.suite << "," <<
+            workload.name << "," <<
+            workload.grid.width() << "x" << workload.grid.height() << "," <<
+            query_count << "," <<
+            (BitFlood::vectorized() ? "avx2" : "scalar") << "," <<
+            mismatches << "," <<
+            flood_per_query << "," <<
+            search_per_query << "\n";
+    }
+    else
+    {
+        std::cout <<
+            "{\"suite\":\"" << workload.suite << "\"" <<
+            ",\"map\":\"" << workload.name << "\"" <<
+            ",\"size\":\"" << workload.grid.width() << "x" << workload.grid.height() << "\"" <<
+            ",\"config\":\"bit-flood\"" <<
+            ",\"queries\":" << query_count <<
+            ",\"kernel\":\"" << (BitFlood::vectorized() ? "avx2" : "scalar") << "\"" <<
+            ",\"mismatches\":" << mismatches <<
+            ",\"flood_ns_per_query\":" << flood_per_query <<
+            ",\"astar_ns_per_query\":" << search_per_query << "}\n";
+    }
+}
+
+
+// Sends every query start to the goal of the first query, once through one shared distance field
+// and once with an A* search per agent. The path costs have to agree.
+static void runField(Workload &workload, const Settings &settings)
+{
+    if (workload.queries.empty())
+    {
+        return;
+    }
+
+    const glm::ivec2 goal = workload.queries.front().goal;
+
+    DistanceField field(workload.grid);
+    Search search;
+
+    const auto build_start = std::chrono::steady_clock::now();
+    field.build(std::span(&goal, 1));
+    const auto build_end = std::chrono::steady_clock::now();
+
+    std::int64_t follow_ns = 0;
+    std::int64_t search_ns = 0;
+    std::size_t mismatches = 0;
+
+    for (const Query &query : workload.queries)
+    {
+        const auto follow_start = std::chrono::steady_clock::now();
+        const PathResult followed = field.path(query.start);
+        const auto search_start = std::chrono::steady_clock::now();
+        const PathResult result = search.findPath(workload.grid, query.start, goal);
+        const auto search_end = std::chrono::steady_clock::now();
+
+        follow_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(search_start - follow_start).count();
+        search_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(search_end - search_start).count();
+
+        mismatches += followed.found != result.found || followed.cost != result.cost;
+    }
+
+    const std::size_t agent_count = workload.queries.size();
+    const std::int64_t build_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(build_end - build_start).count();
+
+    if (settings.csv)
+    {
+        std::cout <<
+            workload.suite << "," <<
+            workload.name << "," <<
+            workload.grid.width() << "x" << workload.grid.height() << "," <<
+            agent_count << "," <<
+            field.threadCount() << "," <<
+            mismatches << "," <<
+            build_ns << "," <<
+            follow_ns << "," <<
+            search_ns << "\n";
+    }
+    else
+    {
+        std::cout <<
+            "{\"suite\":\"" << workload.suite << "\"" <<
+            ",\"map\":\"" << workload.name << "\"" <<
+            ",\"size\":\"" << workload.grid.width() << "x" << workload.grid.height() << "\"" <<
+            ",\"config\":\"distance-field\"" <<
+            ",\"agents\":" << agent_count <<
+            ",\"threads\":" << field.threadCount() <<
+            ",\"mismatches\":" << mismatches <<
+            ",\"build_ns\":" << build_ns <<
+            ",\"follow_ns\":" << follow_ns <<
+            ",\"astar_ns\":" << search_ns << "}\n";
+    }
+}
+
+
+static void usage()
+{
+    std::cerr <<
+        "Usage: astar_bench [options] [scenario.scen ...]\n"
+        "  --size N      edge length of the synthetic maps (default 512)\n"
+        "  --queries N   queries per synthetic map (default 200)\n"
+        "  --seed N      seed for maps and queries (default 1)\n"
+        "  --maps DIR    directory of the .map files named in the scenarios\n"
+        "  --no-synthetic  only run the given scenarios\n"
+        "  --csv         print CSV instead of JSON lines\n"
+        "  --replan      compare D* Lite repairs after edits with planning from scratch\n"
+        "  --landmarks DIR  load ALT tables from DIR, building and saving missing ones\n"
+        "  --flood       compare the word parallel BFS with A* on unit cost maps\n"
+        "  --field       route all queries to one goal through a shared distance field and with A*\n"
+        "\n"
+        "peak_memory_kib is the resident memory a configuration added at its peak on Linux, elsewhere\n"
+        "the peak of the whole process so far.\n";
+}
+
+
+int main(const int argc, char **argv)
+{
+    Settings settings;
+    bool synthetic = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if (argument == "--size" && has_value)
+        {
+            settings.size = std::max(8, std::stoi(argv[++i]));
+        }
+        else if (argument == "--queries" && has_value)
+        {
+            settings.queries = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (argument == "--seed" && has_value)
+        {
+            settings.seed = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--maps" && has_value)
+        {
+            settings.maps = argv[++i];
+        }
+        else if (argument == "--landmarks" && has_value)
+        {
+            settings.landmarks = argv[++i];
+        }
+        else if (argument == "--no-synthetic")
+        {
+            synthetic = false;
+        }
+        else if (argument == "--csv")
+        {
+            settings.csv = true;
+        }
+        else if (argument == "--replan")
+        {
+            settings.replan = true;
+        }
+        else if (argument == "--flood")
+        {
+            settings.flood = true;
+        }
+        else if (argument == "--field")
+        {
+            settings.field = true;
+        }
+        else if (argument.starts_with("--"))
+        {
+            usage();
+            return 1;
+        }
+        else
+        {
+            settings.scenarios.push_back(argument);
+        }
+    }
+
+    if (!instrumented())
+    {
+        std::cerr << "astar_core was built without ASTAR_INSTRUMENTATION, generated and peak_open will be zero\n";
+    }
+
+    std::vector<Configuration> configurations;
+    for (const auto &[mode_name, mode] : {
+            std::pair{"astar", SearchMode::ASTAR},
+            std::pair{"jps", SearchMode::JPS},
+            std::pair{"jps+", SearchMode::JPS_PLUS},
+            std::pair{"bidirectional", SearchMode::BIDIRECTIONAL}})
+    {
+        for (const auto &[list_name, open_list] : {
+                std::pair{"heap", OpenListType::INDEXED_HEAP},
+                std::pair{"bucket", OpenListType::BUCKET_QUEUE}})
+        {
+            SearchOptions options;
+            options.mode = mode;
+            options.open_list = open_list;
+
+            configurations.push_back({std::string(mode_name) + "/" + list_name, options});
+
+            if (mode == SearchMode::ASTAR || mode == SearchMode::BIDIRECTIONAL)
+            {
+                options.connectivity = Connectivity::EIGHT;
+                configurations.push_back({std::string(mode_name) + "-8/" + list_name, options});
+            }
+        }
+    }
+
+    configurations.push_back({"hpa", {}, true});
+
+    for (const auto &[mode_name, mode] : {
+            std::pair{"astar-alt", SearchMode::ASTAR},
+            std::pair{"bidirectional-alt", SearchMode::BIDIRECTIONAL}})
+    {
+        SearchOptions options;
+        options.mode = mode;
+
+        configurations.push_back({std::string(mode_name) + "/heap", options, false, true});
+    }
+
+    configurations.push_back({"astar-cc/heap", {}, false, false, true});
+
+    std::vector<Workload> workloads = scenarioWorkloads(settings);
+    if (synthetic)
+    {
+        std::vector<Workload> generated = syntheticWorkloads(settings);
+        std::ranges::move(generated, std::back_inserter(workloads));
+    }
+
+    if (settings.replan)
+    {
+        if (settings.csv)
+        {
+            std::cout << "suite,map,size,queries,edits_per_query,replan_expanded,full_expanded,replan_ns,full_ns\n";
+        }
+
+        for (Workload &workload : workloads)
+        {
+            runReplanning(workload, settings);
+        }
+
+        return 0;
+    }
+
+    if (settings.flood)
+    {
+        if (settings.csv)
+        {
+            std::cout << "suite,map,size,queries,kernel,mismatches,flood_ns_per_query,astar_ns_per_query\n";
+        }
+
+        for (Workload &workload : workloads)
+        {
+            runFlood(workload, settings);
+        }
+
+        return 0;
+    }
+
+    if (settings.field)
+    {
+        if (settings.csv)
+        {
+            std::cout << "suite,map,size,agents,threads,mismatches,build_ns,follow_ns,astar_ns\n";
+        }
+
+        for (Workload &workload : workloads)
+        {
+            runField(workload, settings);
+        }
+
+        return 0;
+    }
+
+    if (settings.csv)
+    {
+        std::cout << "suite,map,size,config,queries,found,expansions,generated,peak_open,expansions_per_sec,ns_per_query,p50_ns,p99_ns,peak_memory_kib\n";
+    }
+
+    for (Workload &workload : workloads)
+    {
+        for (const Configuration &configuration : configurations)
+        {
+            run(workload, configuration, settings);
+        }
+    }
+
+    return 0;
+}
@@ -3,46 +3,32 @@
 #include "buffer.hpp"
 #include "window.hpp"
 
+#include <algorithm>
+#include <optional>
 #include <random>
 #include <string>
 
 
-[[nodiscard]] static unsigned int heuristic(const glm::ivec2 &current_position, const glm::ivec2 &goal_position)
-{
-    return std::abs(current_position.x - goal_position.x) + std::abs(current_position.y - goal_position.y);
-}
-
-
-[[nodiscard]] static unsigned int index(const glm::ivec2 &position)
-{
-    return position.x + position.y * GLOBAL::GRID_SIZE;
-}
-
-
-bool Tile::operator>(const Tile &other) const
-{
-    if (this->cost() == other.cost())
-    {
-        return this->m_cost_h > other.m_cost_h;
-    }
-
-    return this->cost() > other.cost();
-}
-
-
-unsigned int Tile::cost() const
-{
-    return m_cost_g + m_cost_h;
-}
-
-
-AStar::AStar(const Window &window, Buffer *buffer, const glm::ivec2 &start, const glm::ivec2 &goal):
+AStar::AStar(const Window &window, Buffer *buffer, const glm::ivec2 &grid_size, const glm::ivec2 &start, const glm::ivec2 &goal):
     m_start(start),
     m_goal(goal),
-    m_came_from({CAME_FROM_NONE}),
+    m_grid(grid_size.x, grid_size.y),
+    m_jump_table(m_grid),
+    m_components(m_grid),
+    m_hierarchy(m_grid),
+    m_replanner(m_grid),
+    m_distance_field(m_grid),
+    m_worker(m_search),
     m_buffer(buffer),
     m_window(window)
 {
+    SearchOptions options;
+    options.jump_table = &m_jump_table;
+    options.components = &m_components;
+
+    m_search.options(options);
+    m_search.trace(true);
+
     m_buffer->updateTile(start, TileType::START);
     m_buffer->updateTile(goal, TileType::GOAL);
 }
@@ -50,34 +36,57 @@ AStar::AStar(const Window &window, Buffer *buffer, const glm::ivec2 &start, cons
 
 void AStar::addBlocked(const glm::ivec2 &position)
 {
-    if (m_run_algo || position.x >= GLOBAL::GRID_SIZE || position.y >= GLOBAL::GRID_SIZE || position.x < 0 || position.y < 0)
+    if (m_run_algo || !m_grid.contains(position) || m_grid.blocked(position))
     {
         return;
     }
 
     if (position != m_start && position != m_goal)
     {
-        m_blocked_tiles[index(position)] = true;
+        m_grid.block(position);
         m_buffer->updateTile(position, TileType::BLOCKED);
+        replan();
     }
 }
 
 
 void AStar::removeBlocked(const glm::ivec2 &position)
 {
-    if (m_run_algo || position.x >= GLOBAL::GRID_SIZE || position.y >= GLOBAL::GRID_SIZE || position.x < 0 || position.y < 0)
+    if (m_run_algo || !m_grid.contains(position) || (!m_grid.blocked(position) && m_grid.cost(position) == 1))
     {
         return;
     }
 
     if (position != m_start && position != m_goal)
     {
-        m_blocked_tiles[index(position)] = false;
+        m_grid.unblock(position);
+        m_grid.cost(position, 1);
         m_buffer->updateTile(position, TileType::CLEAR);
+        replan();
     }
 }
 
 
+void AStar::terrain(const glm::ivec2 &position, const int cost)
+{
+    const auto clamped_cost = static_cast<std::uint8_t>(std::clamp(cost, 1, 255));
+
+    if (m_run_algo || !m_grid.contains(position) || m_grid.blocked(position) || m_grid.cost(position) == clamped_cost)
+    {
+        return;
+    }
+
+    m_grid.cost(position, clamped_cost);
+
+    if (position != m_start && position != m_goal)
+    {
+        m_buffer->updateCost(position, m_grid.cost(position));
+    }
+
+    replan();
+}
+
+
 void AStar::start(const glm::ivec2 &start)
 {
     if (m_start_algo)
@@ -117,14 +126,14 @@ void AStar::noise(int percentage)
         percentage = 0;
     }
 
-    const int blocked_count = GLOBAL::GRID_SIZE * GLOBAL::GRID_SIZE * percentage / 100;
+    const long long blocked_count = static_cast<long long>(m_grid.tileCount()) * percentage / 100;
 
     std::random_device device;
     std::mt19937 generator(device());
-    std::uniform_int_distribution distribution_x(0, GLOBAL::GRID_SIZE - 1);
-    std::uniform_int_distribution distribution_y(0, GLOBAL::GRID_SIZE - 1);
+    std::uniform_int_distribution distribution_x(0, m_grid.width() - 1);
+    std::uniform_int_distribution distribution_y(0, m_grid.height() - 1);
 
-    for (int i = 0; i < blocked_count; i++)
+    for (long long i = 0; i < blocked_count; i++)
     {
         int x = distribution_x(generator);
         int y = distribution_y(generator);
@@ -140,9 +149,141 @@ void AStar::noise(int percentage)
 }
 
 
+SearchMode AStar::mode() const
+{
+    return m_search.options().mode;
+}
+
+
+void AStar::mode(const SearchMode mode)
+{
+    if (m_start_algo)
+    {
+        return;
+    }
+
+    SearchOptions options = m_search.options();
+    options.mode = mode;
+
+    m_search.options(options);
+}
+
+
+Connectivity AStar::connectivity() const
+{
+    return m_search.options().connectivity;
+}
+
+
+void AStar::connectivity(const Connectivity connectivity)
+{
+    if (m_start_algo)
+    {
+        return;
+    }
+
+    SearchOptions options = m_search.options();
+    options.connectivity = connectivity;
+
+    m_search.options(options);
+    m_path_cache.connectivity(connectivity);
+
+    if (connectivity != Connectivity::FOUR)
+    {
+        m_flow_field = false;
+    }
+}
+
+
+CornerPolicy AStar::cornerPolicy() const
+{
+    return m_search.options().corner_policy;
+}
+
+
+void AStar::cornerPolicy(const CornerPolicy corner_policy)
+{
+    if (m_start_algo)
+    {
+        return;
+    }
+
+    SearchOptions options = m_search.options();
+    options.corner_policy = corner_policy;
+
+    m_search.options(options);
+    m_path_cache.clear();
+}
+
+
+bool AStar::hierarchical() const
+{
+    return m_hierarchical;
+}
+
+
+void AStar::hierarchical(const bool hierarchical)
+{
+    if (m_start_algo)
+    {
+        return;
+    }
+
+    // HPA* paths are near optimal only, they must not answer exact queries.
+    if (hierarchical != m_hierarchical)
+    {
+        m_path_cache.clear();
+    }
+
+    m_hierarchical = hierarchical;
+}
+
+
+bool AStar::incremental() const
+{
+    return m_incremental;
+}
+
+
+void AStar::incremental(const bool incremental)
+{
+    if (m_start_algo)
+    {
+        return;
+    }
+
+    m_incremental = incremental;
+}
+
+
+bool AStar::flowField() const
+{
+    return m_flow_field;
+}
+
+
+void AStar::flowField(const bool flow_field)
+{
+    if (m_start_algo)
+    {
+        return;
+    }
+
+    // The field only knows 4-connected moves, its paths would poison exact 8-connected cache hits.
+    m_flow_field = flow_field && m_search.options().connectivity == Connectivity::FOUR;
+}
+
+
+const PathCacheStats &AStar::cacheStats() const
+{
+    return m_path_cache.stats();
+}
+
+
 void AStar::pause()
 {
     m_run_algo = false;
+    m_worker.pause();
 
     m_window.title("AStar - Paused");
 }
@@ -152,16 +293,16 @@ void AStar::reset()
 {
     m_start_algo = false;
     m_run_algo = false;
+    m_finished = false;
+    m_worker.clear();
 
     m_buffer->clear();
     m_buffer->updateTile(m_start, TileType::START);
     m_buffer->updateTile(m_goal, TileType::GOAL);
 
-    m_visited_tiles.reset();
-    m_blocked_tiles.reset();
-    std::ranges::fill(m_came_from, CAME_FROM_NONE);
-    m_cost_g_map.clear();
-    m_priority_queue = std::priority_queue<Tile, std::vector<Tile>, std::greater<>>();
+    m_grid.clear();
+    m_search.reset();
+    m_path.clear();
 
     m_window.title("AStar");
 }
@@ -178,19 +319,96 @@ void AStar::resume()
 void AStar::run()
 {
     m_start_algo = true;
-    m_run_algo = true;
 
-    const Tile start_tile = {
-        m_start,
-        0,
-        heuristic(m_start, m_goal)
-    };
+    // Nothing to animate if the map has not changed since the route was found.
+    if (!m_incremental)
+    {
+        if (const std::optional<PathResult> cached = m_path_cache.find(m_grid, m_start, m_goal))
+        {
+            m_run_algo = true;
+            m_finished = true;
+            m_search.reset();
+
+            createPath(*cached);
+            m_window.title("AStar - Path length " + std::to_string(cached->path.size() + 1) + ", cost " + std::to_string(cached->cost) + " (cached)");
+            return;
+        }
+    }
+
+    // HPA* answers in one go, there are no intermediate steps to animate. The run counts as finished
+    // so edits wait for a reset, like they do after a stepped search.
+    if (m_hierarchical)
+    {
+        m_run_algo = true;
+        m_finished = true;
+        m_components.update();
+
+        const PathResult result = m_components.connected(m_start, m_goal) ? m_hierarchy.findPath(m_start, m_goal) : PathResult();
+        if (result.found)
+        {
+            m_path_cache.insert(m_grid, result);
+            createPath(result);
+        }
+        else
+        {
+            m_window.title("AStar - No Path");
+        }
+        return;
+    }
+
+    // The field serves every start heading for this goal until the map changes.
+    if (m_flow_field)
+    {
+        m_run_algo = true;
+        m_finished = true;
+
+        const std::span<const glm::ivec2> goals = m_distance_field.goals();
+        if (goals.size() != 1 || goals.front() != m_goal)
+        {
+            m_distance_field.build(std::span(&m_goal, 1));
+        }
+        m_distance_field.update();
+
+        const PathResult result = m_distance_field.path(m_start);
+        if (result.found)
+        {
+            m_path_cache.insert(m_grid, result);
+            createPath(result);
+        }
+        else
+        {
+            m_window.title("AStar - No Path");
+        }
+        return;
+    }
+
+    // D* Lite keeps its tree, edits made afterwards only repair the path.
+    if (m_incremental)
+    {
+        m_replanner.begin(m_start, m_goal);
+        replan();
+        return;
+    }
+
+    m_run_algo = true;
 
-    m_visited_tiles[index(m_start)] = true;
-    m_priority_queue.push(start_tile);
-    m_came_from[index(m_start)] = CAME_FROM_NONE;
+    m_jump_table.update();
+    m_components.update();
+    m_search.begin(m_grid, m_start, m_goal);
+    m_finished = m_search.state() != SearchState::SEARCHING;
 
     m_window.title("AStar - Searching...");
+
+    if (m_search.state() == SearchState::FOUND)
+    {
+        const PathResult result = m_search.path();
+        m_path_cache.insert(m_grid, result);
+        createPath(result);
+    }
+    else if (m_search.state() == SearchState::NO_PATH)
+    {
+        m_window.title("AStar - No Path");
+    }
 }
 
 
@@ -206,96 +424,115 @@ bool AStar::started() const
 }
 
 
-void AStar::step()
+// The search is only read here while the worker is idle, otherwise its published copy is.
+SearchStats AStar::stats() const
 {
-    if (!m_run_algo || m_visited_tiles[index(m_goal)])
-    {
-        return;
-    }
-    if (m_priority_queue.empty())
+    return m_worker.busy() ? m_worker.stats() : m_search.stats();
+}
+
+
+StepProgress AStar::lastStep() const
+{
+    return m_worker.progress();
+}
+
+
+std::uint64_t AStar::expansions() const
+{
+    return m_worker.steps();
+}
+
+
+// Hands the budget to the worker, its results show up through update(). The search may only be
+// read once the worker is idle, only this thread grants it new work.
+void AStar::step(const StepBudget &budget)
+{
+    if (!m_run_algo || m_finished || m_worker.busy() || m_search.state() != SearchState::SEARCHING)
     {
-        m_window.title("AStar - No Path");
         return;
     }
 
-    const Tile current = m_priority_queue.top();
-    m_priority_queue.pop();
+    m_worker.grant(budget);
+}
+
+
+void AStar::update()
+{
+    const bool idle = !m_worker.busy();
 
-    const unsigned int current_index = index(current.m_position);
+    m_worker.drain(m_discovered);
+    for (const unsigned int index : m_discovered)
+    {
+        const glm::ivec2 position = m_grid.position(index);
+        if (position != m_start && position != m_goal)
+        {
+            m_buffer->updateTile(position, TileType::VISITED);
+        }
+    }
+    m_discovered.clear();
 
-    if (current.m_cost_g > m_cost_g_map[current_index])
+    if (!idle || !m_run_algo || m_finished)
     {
         return;
     }
 
-    m_visited_tiles[current_index] = true;
+    const SearchState state = m_search.state();
 
-    if (current.m_position == m_goal) [[unlikely]]
+    if (state == SearchState::FOUND)
     {
-        createPath();
-        return;
+        const PathResult result = m_search.path();
+        m_path_cache.insert(m_grid, result);
+        createPath(result);
+        m_finished = true;
     }
+    else if (state == SearchState::NO_PATH)
+    {
+        m_window.title("AStar - No Path");
+        m_finished = true;
+    }
+}
 
-    constexpr std::array directions = {
-            glm::ivec2(0, 1),
-            glm::ivec2(1, 0),
-            glm::ivec2(0, -1),
-            glm::ivec2(-1, 0)
-    };
 
-    for (const glm::ivec2 &offset : directions)
+void AStar::replan()
+{
+    if (!m_incremental || !m_start_algo)
     {
-        glm::ivec2 neighbor_position = current.m_position + offset;
+        return;
+    }
 
-        if (neighbor_position.x < 0 || neighbor_position.y < 0 ||
-            neighbor_position.x >= GLOBAL::GRID_SIZE || neighbor_position.y >= GLOBAL::GRID_SIZE) [[unlikely]]
+    for (const glm::ivec2 &position : m_path)
+    {
+        if (position != m_start && position != m_goal && !m_grid.blocked(position))
         {
-            continue;
+            m_buffer->updateCost(position, m_grid.cost(position));
         }
+    }
 
-        unsigned int neighbour_index = index(neighbor_position);
-        if (m_blocked_tiles[neighbour_index])
-        {
-            continue;
-        }
+    const PathResult result = m_replanner.plan();
+    m_path = result.path;
 
-        const unsigned int new_g = current.m_cost_g + 1;
-        if (!m_cost_g_map.contains(neighbour_index) || new_g < m_cost_g_map[neighbour_index])
-        {
-            m_cost_g_map[neighbour_index] = new_g;
-            m_came_from[neighbour_index] = static_cast<int>(current_index);
-
-            Tile neighbor_tile = {
-                    neighbor_position,
-                    new_g,
-                    heuristic(neighbor_position, m_goal)
-            };
-            m_priority_queue.push(neighbor_tile);
-
-            if (neighbor_position != m_start && neighbor_position != m_goal)
-            {
-                m_buffer->updateTile(neighbor_position, TileType::VISITED);
-            }
-        }
+    if (!result.found)
+    {
+        m_window.title("AStar - No Path");
+        return;
     }
+
+    createPath(result);
+    m_window.title(
+        "AStar - Path length " + std::to_string(result.path.size() + 1) + ", cost " + std::to_string(result.cost) +
+        ", expanded " + std::to_string(m_replanner.stats().expanded));
 }
 
 
-void AStar::createPath() const
+void AStar::createPath(const PathResult &result) const
 {
-    int came_from_index = static_cast<int>(index(m_goal));
-    int count = 1;
-
-    while (came_from_index != CAME_FROM_NONE)
+    for (const glm::ivec2 &position : result.path)
     {
-        if (came_from_index != static_cast<int>(index(m_start)) && came_from_index != static_cast<int>(index(m_goal)))
+        if (position != m_start && position != m_goal)
         {
-            m_buffer->updateTile(came_from_index, TileType::PATH);
+            m_buffer->updateTile(position, TileType::PATH);
         }
-
-        came_from_index = m_came_from[came_from_index];
-        count++;
     }
 
-    m_window.title("AStar - Path length " + std::to_string(count));
+    m_window.title("AStar - Path length " + std::to_string(result.path.size() + 1) + ", cost " + std::to_string(result.cost));
 }
@@ -1,74 +1,96 @@
 #pragma once
 
 
-#include "global.hpp"
+#include "component_index.hpp"
+#include "distance_field.hpp"
+#include "grid.hpp"
+#include "hierarchy.hpp"
+#include "jump_table.hpp"
+#include "path_cache.hpp"
+#include "replanner.hpp"
+#include "search.hpp"
+#include "search_worker.hpp"
 
 #include <glm/glm.hpp>
 
-#include <array>
-#include <bitset>
-#include <queue>
-#include <unordered_map>
+#include <vector>
 
 
 class Buffer;
 class Window;
 
 
-class Tile
-{
-public:
-    bool operator>(const Tile &other) const;
-
-    [[nodiscard]] unsigned int cost() const;
-
-
-    glm::ivec2 m_position;
-    unsigned int m_cost_g;
-    unsigned int m_cost_h;
-};
-
-
 class AStar
 {
 public:
-    AStar(const Window &window, Buffer *buffer, const glm::ivec2 &start, const glm::ivec2 &goal);
+    AStar(const Window &window, Buffer *buffer, const glm::ivec2 &grid_size, const glm::ivec2 &start, const glm::ivec2 &goal);
 
     void addBlocked(const glm::ivec2 &position);
     void removeBlocked(const glm::ivec2 &position);
+    void terrain(const glm::ivec2 &position, int cost);
 
     void start(const glm::ivec2 &start);
     void goal(const glm::ivec2 &goal);
 
     void noise(int percentage);
 
+    [[nodiscard]] SearchMode mode() const;
+    void mode(SearchMode mode);
+    [[nodiscard]] Connectivity connectivity() const;
+    void connectivity(Connectivity connectivity);
+    [[nodiscard]] CornerPolicy cornerPolicy() const;
+    void cornerPolicy(CornerPolicy corner_policy);
+    [[nodiscard]] bool hierarchical() const;
+    void hierarchical(bool hierarchical);
+    [[nodiscard]] bool incremental() const;
+    void incremental(bool incremental);
+    [[nodiscard]] bool flowField() const;
+    // Stays off unless the search is 4-connected.
+    void flowField(bool flow_field);
+    [[nodiscard]] const PathCacheStats &cacheStats() const;
+
     void pause();
     void reset();
     void resume();
     void run();
     [[nodiscard]] bool running() const;
     [[nodiscard]] bool started() const;
-    void step();
+    [[nodiscard]] SearchStats stats() const;
+    [[nodiscard]] StepProgress lastStep() const;
+    // Nodes the stepped search expanded since the last reset.
+    [[nodiscard]] std::uint64_t expansions() const;
+    void step(const StepBudget &budget = {});
+    void update();
 
 
 private:
     glm::ivec2 m_start;
     glm::ivec2 m_goal;
 
-    const int CAME_FROM_NONE = -1;
     bool m_start_algo = false;
     bool m_run_algo = false;
-
-    std::bitset<GLOBAL::GRID_SIZE * GLOBAL::GRID_SIZE> m_visited_tiles;
-    std::bitset<GLOBAL::GRID_SIZE * GLOBAL::GRID_SIZE> m_blocked_tiles;
-    std::array<int, GLOBAL::GRID_SIZE * GLOBAL::GRID_SIZE> m_came_from;
-    std::unordered_map<unsigned int, unsigned int> m_cost_g_map;
-
-    std::priority_queue<Tile, std::vector<Tile>, std::greater<>> m_priority_queue;
+    bool m_hierarchical = false;
+    bool m_incremental = false;
+    bool m_flow_field = false;
+    bool m_finished = false;
+
+    Grid m_grid;
+    JumpTable m_jump_table;
+    ComponentIndex m_components;
+    Hierarchy m_hierarchy;
+    Replanner m_replanner;
+    DistanceField m_distance_field;
+    Search m_search;
+    PathCache m_path_cache;
+    SearchWorker m_worker;
+
+    std::vector<glm::ivec2> m_path;
+    std::vector<unsigned int> m_discovered;
 
     Buffer *m_buffer;
     const Window &m_window;
 
 
-    void createPath() const;
+    void replan();
+    void createPath(const PathResult &result) const;
 };
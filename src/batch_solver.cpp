@@ -0,0 +1,64 @@
+#include "batch_solver.hpp"
+
+#include "grid.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+
+static constexpr std::size_t CHUNKS_PER_THREAD = 8;
+static constexpr std::size_t MIN_CHUNK_SIZE = 4;
+
+
+BatchSolver::BatchSolver(const unsigned int thread_count, const SearchOptions &options):
+    m_pool(thread_count)
+{
+    m_searches.reserve(m_pool.threadCount());
+    for (unsigned int i = 0; i < m_pool.threadCount(); i++)
+    {
+        m_searches.emplace_back(options);
+    }
+}
+
+
+unsigned int BatchSolver::threadCount() const
+{
+    return m_pool.threadCount();
+}
+
+
+BatchResult BatchSolver::solve(const Grid &grid, const std::span<const Query> queries)
+{
+    BatchResult batch;
+    batch.results.resize(queries.size());
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    // Small chunks so stealing can even out queries of very different length.
+    const std::size_t chunk_size = std::max(MIN_CHUNK_SIZE, queries.size() / (m_pool.threadCount() * CHUNKS_PER_THREAD));
+
+    for (std::size_t begin = 0; begin < queries.size(); begin += chunk_size)
+    {
+        const std::size_t end = std::min(begin + chunk_size, queries.size());
+
+        m_pool.submit([this, &grid, &queries, &batch, begin, end](const unsigned int worker)
+        {
+            Search &search = m_searches[worker];
+
+            for (std::size_t i = begin; i < end; i++)
+            {
+                batch.results[i] = search.findPath(grid, queries[i].start, queries[i].goal);
+            }
+        });
+    }
+
+    m_pool.wait();
+
+    batch.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    if (batch.seconds > 0.0)
+    {
+        batch.queries_per_second = static_cast<double>(queries.size()) / batch.seconds;
+    }
+
+    return batch;
+}
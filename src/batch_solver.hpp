@@ -0,0 +1,46 @@
+#pragma once
+
+
+#include "search.hpp"
+#include "thread_pool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <span>
+#include <vector>
+
+
+class Grid;
+
+
+struct Query
+{
+    glm::ivec2 start;
+    glm::ivec2 goal;
+};
+
+
+struct BatchResult
+{
+    std::vector<PathResult> results;
+    double seconds = 0.0;
+    double queries_per_second = 0.0;
+};
+
+
+// Answers many queries against one read-only grid. Each pool worker keeps its
+// own Search, so open lists and cost tables are reused across batches.
+class BatchSolver
+{
+public:
+    explicit BatchSolver(unsigned int thread_count = std::thread::hardware_concurrency(), const SearchOptions &options = {});
+
+    [[nodiscard]] unsigned int threadCount() const;
+
+    [[nodiscard]] BatchResult solve(const Grid &grid, std::span<const Query> queries);
+
+
+private:
+    ThreadPool m_pool;
+    std::vector<Search> m_searches;
+};
@@ -0,0 +1,272 @@
+#include "bit_flood.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+static constexpr std::size_t WORD_BITS = 64;
+
+
+BitFlood::BitFlood(Grid &grid):
+    m_grid(grid)
+{
+    m_grid.listen(this);
+    mirror();
+}
+
+
+BitFlood::~BitFlood()
+{
+    m_grid.unlisten(this);
+}
+
+
+bool BitFlood::reachable(const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    return distance(start, goal) != UNREACHED;
+}
+
+
+unsigned int BitFlood::distance(const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    if (!m_grid.contains(goal) || m_grid.blocked(goal) || !seed(start))
+    {
+        return UNREACHED;
+    }
+
+    const std::size_t goal_word = word(goal);
+    const std::uint64_t goal_bit = bit(goal);
+
+    for (unsigned int steps = 0;; steps++)
+    {
+        if (m_visited[goal_word] & goal_bit)
+        {
+            return steps;
+        }
+
+        if (!expand())
+        {
+            return UNREACHED;
+        }
+    }
+}
+
+
+void BitFlood::distances(const glm::ivec2 &source, std::vector<unsigned int> &field)
+{
+    field.assign(m_grid.tileCount(), UNREACHED);
+
+    if (!seed(source))
+    {
+        return;
+    }
+
+    field[m_grid.index(source)] = 0;
+
+    for (unsigned int steps = 1; expand(&field, steps); steps++)
+    {
+    }
+}
+
+
+bool BitFlood::vectorized()
+{
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+void BitFlood::tileChanged(const glm::ivec2 &position)
+{
+    if (m_grid.blocked(position))
+    {
+        m_free[word(position)] &= ~bit(position);
+    }
+    else
+    {
+        m_free[word(position)] |= bit(position);
+    }
+}
+
+
+void BitFlood::gridChanged()
+{
+    mirror();
+}
+
+
+std::size_t BitFlood::word(const glm::ivec2 &position) const
+{
+    return static_cast<std::size_t>(position.y + 1) * m_stride + static_cast<std::size_t>(position.x) / WORD_BITS + 1;
+}
+
+
+std::uint64_t BitFlood::bit(const glm::ivec2 &position)
+{
+    return std::uint64_t{1} << (static_cast<std::size_t>(position.x) % WORD_BITS);
+}
+
+
+void BitFlood::mirror()
+{
+    m_stride = (static_cast<std::size_t>(m_grid.width()) + WORD_BITS - 1) / WORD_BITS + 2;
+
+    const std::size_t word_count = (static_cast<std::size_t>(m_grid.height()) + 2) * m_stride;
+    m_free.assign(word_count, 0);
+    m_visited.assign(word_count, 0);
+    m_frontier.assign(word_count, 0);
+    m_next.assign(word_count, 0);
+
+    for (int y = 0; y < m_grid.height(); y++)
+    {
+        for (int x = 0; x < m_grid.width(); x++)
+        {
+            if (!m_grid.blocked({x, y}))
+            {
+                m_free[word({x, y})] |= bit({x, y});
+            }
+        }
+    }
+}
+
+
+bool BitFlood::seed(const glm::ivec2 &source)
+{
+    if (!m_grid.contains(source) || m_grid.blocked(source))
+    {
+        return false;
+    }
+
+    std::ranges::fill(m_visited, 0);
+    std::ranges::fill(m_frontier, 0);
+    std::ranges::fill(m_next, 0);
+
+    m_visited[word(source)] = bit(source);
+    m_frontier[word(source)] = bit(source);
+    m_first_row = source.y + 1;
+    m_last_row = source.y + 1;
+
+    return true;
+}
+
+
+// Grows the frontier by one step. Rows next to the frontier band are the only ones that can change.
+bool BitFlood::expand(std::vector<unsigned int> *field, const unsigned int steps)
+{
+    const int old_first_row = m_first_row;
+    const int old_last_row = m_last_row;
+    const int first_row = std::max(m_first_row - 1, 1);
+    const int last_row = std::min(m_last_row + 1, m_grid.height());
+
+    m_first_row = last_row + 1;
+    m_last_row = first_row - 1;
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+        if (expandRow(row, field, steps))
+        {
+            m_first_row = std::min(m_first_row, row);
+            m_last_row = std::max(m_last_row, row);
+        }
+    }
+
+    std::swap(m_frontier, m_next);
+
+    // The old frontier is left in m_next. Rows the next step overwrites anyway keep their bits, the rest is cleared.
+    for (int row = old_first_row; row <= old_last_row; row++)
+    {
+        if (row < m_first_row - 1 || row > m_last_row + 1)
+        {
+            std::fill_n(m_next.begin() + static_cast<std::ptrdiff_t>(static_cast<std::size_t>(row) * m_stride), m_stride, 0);
+        }
+    }
+
+    return m_first_row <= m_last_row;
+}
+
+
+void BitFlood::record(const int row, const std::size_t column, std::uint64_t layer, std::vector<unsigned int> &field, const unsigned int steps) const
+{
+    while (layer != 0)
+    {
+        const auto x = static_cast<int>((column - 1) * WORD_BITS) + std::countr_zero(layer);
+        field[m_grid.index({x, row - 1})] = steps;
+        layer &= layer - 1;
+    }
+}
+
+
+bool BitFlood::expandRow(const int row, std::vector<unsigned int> *field, const unsigned int steps)
+{
+    const std::size_t row_begin = static_cast<std::size_t>(row) * m_stride;
+    const std::uint64_t *frontier = m_frontier.data() + row_begin;
+    const std::uint64_t *above = frontier - m_stride;
+    const std::uint64_t *below = frontier + m_stride;
+    const std::uint64_t *free = m_free.data() + row_begin;
+    std::uint64_t *visited = m_visited.data() + row_begin;
+    std::uint64_t *next = m_next.data() + row_begin;
+
+    std::size_t column = 1;
+    const std::size_t end = m_stride - 1;
+    std::uint64_t any = 0;
+
+#if defined(__AVX2__)
+    // Neighbouring words come from unaligned loads one word to either side, the zero frame covers the row ends.
+    for (; column + 4 <= end; column += 4)
+    {
+        const __m256i centre = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(frontier + column));
+        const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(frontier + column - 1));
+        const __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(frontier + column + 1));
+
+        __m256i grown = _mm256_or_si256(centre, _mm256_slli_epi64(centre, 1));
+        grown = _mm256_or_si256(grown, _mm256_srli_epi64(centre, 1));
+        grown = _mm256_or_si256(grown, _mm256_srli_epi64(left, 63));
+        grown = _mm256_or_si256(grown, _mm256_slli_epi64(right, 63));
+        grown = _mm256_or_si256(grown, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(above + column)));
+        grown = _mm256_or_si256(grown, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(below + column)));
+
+        const __m256i old = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(visited + column));
+        const __m256i layer = _mm256_andnot_si256(old, _mm256_and_si256(grown, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(free + column))));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(next + column), layer);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(visited + column), _mm256_or_si256(old, layer));
+
+        if (!_mm256_testz_si256(layer, layer))
+        {
+            any = 1;
+
+            for (std::size_t i = 0; field != nullptr && i < 4; i++)
+            {
+                record(row, column + i, next[column + i], *field, steps);
+            }
+        }
+    }
+#endif
+
+    for (; column < end; column++)
+    {
+        const std::uint64_t centre = frontier[column];
+        const std::uint64_t grown =
+            centre | centre << 1 | centre >> 1 |
+            frontier[column - 1] >> 63 | frontier[column + 1] << 63 |
+            above[column] | below[column];
+
+        next[column] = grown & free[column] & ~visited[column];
+        visited[column] |= next[column];
+        any |= next[column];
+
+        if (field != nullptr && next[column] != 0)
+        {
+            record(row, column, next[column], *field, steps);
+        }
+    }
+
+    return any != 0;
+}
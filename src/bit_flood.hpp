@@ -0,0 +1,64 @@
+#pragma once
+
+
+#include "grid.hpp"
+
+#include <glm/glm.hpp>
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+
+// Word parallel breadth first flood over unit steps of a 4-connected grid. Free tiles are mirrored
+// into row aligned 64 bit words, so one layer of the frontier grows 64 tiles per shift and mask,
+// or 256 with AVX2. Every row and the grid itself are framed by zero words, the kernel never needs
+// a bounds check. Terrain costs are ignored, distances count steps.
+class BitFlood final : public GridListener
+{
+public:
+    static constexpr unsigned int UNREACHED = UINT_MAX;
+
+
+    explicit BitFlood(Grid &grid);
+    BitFlood(const BitFlood &) = delete;
+    ~BitFlood() override;
+
+    void operator=(const BitFlood &) = delete;
+
+    [[nodiscard]] bool reachable(const glm::ivec2 &start, const glm::ivec2 &goal);
+    [[nodiscard]] unsigned int distance(const glm::ivec2 &start, const glm::ivec2 &goal);
+    // Steps from the source to every tile, UNREACHED for blocked and cut off tiles.
+    void distances(const glm::ivec2 &source, std::vector<unsigned int> &field);
+
+    [[nodiscard]] static bool vectorized();
+
+    void tileChanged(const glm::ivec2 &position) override;
+    void gridChanged() override;
+
+
+private:
+    Grid &m_grid;
+
+    // Words per row including the zero word on either side.
+    std::size_t m_stride = 0;
+
+    std::vector<std::uint64_t> m_free;
+    std::vector<std::uint64_t> m_visited;
+    std::vector<std::uint64_t> m_frontier;
+    std::vector<std::uint64_t> m_next;
+
+    // Rows holding frontier bits, offset by the zero row on top.
+    int m_first_row = 0;
+    int m_last_row = 0;
+
+
+    [[nodiscard]] std::size_t word(const glm::ivec2 &position) const;
+    [[nodiscard]] static std::uint64_t bit(const glm::ivec2 &position);
+
+    void mirror();
+    bool seed(const glm::ivec2 &source);
+    bool expand(std::vector<unsigned int> *field = nullptr, unsigned int steps = 0);
+    bool expandRow(int row, std::vector<unsigned int> *field, unsigned int steps);
+    void record(int row, std::size_t column, std::uint64_t layer, std::vector<unsigned int> &field, unsigned int steps) const;
+};
@@ -0,0 +1,69 @@
+#include "bit_set.hpp"
+
+#include <algorithm>
+
+
+static constexpr std::size_t WORD_BITS = 64;
+
+
+[[nodiscard]] static std::size_t wordCount(const std::size_t size)
+{
+    return (size + WORD_BITS - 1) / WORD_BITS;
+}
+
+
+BitSet::BitSet(const std::size_t size):
+    m_size(size),
+    m_words(wordCount(size), 0)
+{
+}
+
+
+bool BitSet::test(const std::size_t index) const
+{
+    return (m_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1u;
+}
+
+
+void BitSet::set(const std::size_t index)
+{
+    m_words[index / WORD_BITS] |= std::uint64_t{1} << (index % WORD_BITS);
+}
+
+
+void BitSet::set(const std::size_t index, const bool value)
+{
+    if (value)
+    {
+        set(index);
+    }
+    else
+    {
+        reset(index);
+    }
+}
+
+
+void BitSet::reset(const std::size_t index)
+{
+    m_words[index / WORD_BITS] &= ~(std::uint64_t{1} << (index % WORD_BITS));
+}
+
+
+void BitSet::clear()
+{
+    std::ranges::fill(m_words, 0);
+}
+
+
+void BitSet::resize(const std::size_t size)
+{
+    m_size = size;
+    m_words.resize(wordCount(size), 0);
+}
+
+
+std::size_t BitSet::size() const
+{
+    return m_size;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+
+class BitSet
+{
+public:
+    BitSet() = default;
+    explicit BitSet(std::size_t size);
+
+    [[nodiscard]] bool test(std::size_t index) const;
+    void set(std::size_t index);
+    void set(std::size_t index, bool value);
+    void reset(std::size_t index);
+
+    void clear();
+    void resize(std::size_t size);
+    [[nodiscard]] std::size_t size() const;
+
+
+private:
+    std::size_t m_size = 0;
+    std::vector<std::uint64_t> m_words;
+};
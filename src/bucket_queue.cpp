@@ -0,0 +1,197 @@
+#include "bucket_queue.hpp"
+
+#include <algorithm>
+#include <bit>
+
+
+static constexpr auto greater_key = [](const auto &left, const auto &right)
+{
+    return left.key > right.key;
+};
+
+
+BucketQueue::BucketQueue(const TieBreak tie_break):
+    m_tie_break(tie_break),
+    m_buckets(INITIAL_BUCKETS),
+    m_mask(INITIAL_BUCKETS - 1)
+{
+}
+
+
+void BucketQueue::tieBreak(const TieBreak tie_break)
+{
+    clear();
+    m_tie_break = tie_break;
+}
+
+
+void BucketQueue::resize(const std::size_t tile_count)
+{
+    clear();
+    m_keys.assign(tile_count, KEY_NONE);
+}
+
+
+void BucketQueue::clear()
+{
+    if (m_stored > 0)
+    {
+        for (unsigned int offset = 0; offset <= m_highest - m_lowest; offset++)
+        {
+            std::vector<Entry> &entries = m_buckets[(m_lowest + offset) & m_mask];
+            for (const Entry &entry : entries)
+            {
+                m_keys[entry.index] = KEY_NONE;
+            }
+            entries.clear();
+        }
+    }
+
+    m_lowest = 0;
+    m_highest = 0;
+    m_stored = 0;
+    m_size = 0;
+}
+
+
+bool BucketQueue::empty() const
+{
+    return m_size == 0;
+}
+
+
+std::size_t BucketQueue::size() const
+{
+    return m_size;
+}
+
+
+void BucketQueue::push(const std::uint32_t index, const std::uint64_t key)
+{
+    const unsigned int cost_f = keyCostF(key);
+
+    if (m_stored == 0)
+    {
+        m_lowest = cost_f;
+        m_highest = cost_f;
+    }
+    else
+    {
+        const unsigned int lowest = std::min(m_lowest, cost_f);
+        const unsigned int highest = std::max(m_highest, cost_f);
+
+        if (highest - lowest >= m_buckets.size()) [[unlikely]]
+        {
+            grow(static_cast<std::size_t>(highest - lowest) + 1);
+        }
+
+        m_lowest = lowest;
+        m_highest = highest;
+    }
+
+    if (m_keys[index] == KEY_NONE)
+    {
+        m_size++;
+        ASTAR_COUNT(m_stats.pushes++);
+        ASTAR_COUNT(m_stats.peak_size = std::max<std::uint64_t>(m_stats.peak_size, m_size));
+    }
+    else
+    {
+        ASTAR_COUNT(m_stats.decreases++);
+    }
+
+    m_keys[index] = key;
+    m_stored++;
+
+    std::vector<Entry> &entries = m_buckets[cost_f & m_mask];
+    entries.push_back({key, index});
+    if (m_tie_break == TieBreak::LOWEST_H)
+    {
+        std::ranges::push_heap(entries, greater_key);
+    }
+}
+
+
+std::uint32_t BucketQueue::pop()
+{
+    const std::uint32_t index = front().index;
+    std::vector<Entry> &entries = m_buckets[m_lowest & m_mask];
+
+    if (m_tie_break == TieBreak::LOWEST_H)
+    {
+        std::ranges::pop_heap(entries, greater_key);
+    }
+    entries.pop_back();
+
+    m_keys[index] = KEY_NONE;
+    m_stored--;
+    m_size--;
+    ASTAR_COUNT(m_stats.pops++);
+
+    return index;
+}
+
+
+std::uint64_t BucketQueue::topKey()
+{
+    return front().key;
+}
+
+
+// Moves the cursor to the best live entry, dropping stale entries on the way.
+BucketQueue::Entry &BucketQueue::front()
+{
+    while (true)
+    {
+        std::vector<Entry> &entries = m_buckets[m_lowest & m_mask];
+        if (entries.empty())
+        {
+            m_lowest++;
+            continue;
+        }
+
+        Entry &entry = m_tie_break == TieBreak::LOWEST_H ? entries.front() : entries.back();
+        if (m_keys[entry.index] == entry.key)
+        {
+            return entry;
+        }
+
+        if (m_tie_break == TieBreak::LOWEST_H)
+        {
+            std::ranges::pop_heap(entries, greater_key);
+        }
+        entries.pop_back();
+        m_stored--;
+        ASTAR_COUNT(m_stats.stale_pops++);
+    }
+}
+
+
+// Moves the stored window into a ring wide enough for span f values. Every bucket holds a
+// single f, so it moves as a whole and keeps its heap order.
+void BucketQueue::grow(const std::size_t span)
+{
+    std::vector<std::vector<Entry>> buckets(std::bit_ceil(span));
+    const std::size_t mask = buckets.size() - 1;
+
+    for (unsigned int offset = 0; offset <= m_highest - m_lowest; offset++)
+    {
+        const unsigned int cost_f = m_lowest + offset;
+        buckets[cost_f & mask] = std::move(m_buckets[cost_f & m_mask]);
+    }
+
+    m_buckets = std::move(buckets);
+    m_mask = mask;
+}
+
+
+const OpenListStats &BucketQueue::stats() const
+{
+    return m_stats;
+}
+
+
+void BucketQueue::resetStats()
+{
+    m_stats = {};
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+
+#include "open_list.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+enum class TieBreak
+{
+    LIFO,
+    LOWEST_H
+};
+
+
+// Open list for integer f-costs: a ring of buckets, one per f value, scanned by
+// a cursor that only moves backwards if a key below it is pushed. A consistent
+// heuristic keeps every stored key within about two edge costs of the cursor,
+// so the ring only spans that window however far f climbs. A key outside the
+// window doubles the ring. Improved keys leave a stale entry behind that is
+// skipped when it reaches the front.
+class BucketQueue
+{
+public:
+    explicit BucketQueue(TieBreak tie_break = TieBreak::LIFO);
+
+    void tieBreak(TieBreak tie_break);
+
+    void resize(std::size_t tile_count);
+    void clear();
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+
+    void push(std::uint32_t index, std::uint64_t key);
+    std::uint32_t pop();
+    [[nodiscard]] std::uint64_t topKey();
+
+    [[nodiscard]] const OpenListStats &stats() const;
+    void resetStats();
+
+
+private:
+    static constexpr std::uint64_t KEY_NONE = UINT64_MAX;
+    static constexpr std::size_t INITIAL_BUCKETS = 1024;
+
+
+    struct Entry
+    {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+
+    TieBreak m_tie_break;
+
+    // Bucket f lives at f & m_mask, the ring size is a power of two.
+    std::vector<std::vector<Entry>> m_buckets;
+    std::size_t m_mask;
+    std::vector<std::uint64_t> m_keys;
+
+    // Every stored entry, stale ones included, has an f between the two.
+    unsigned int m_lowest = 0;
+    unsigned int m_highest = 0;
+    std::size_t m_stored = 0;
+    std::size_t m_size = 0;
+
+    OpenListStats m_stats;
+
+
+    Entry &front();
+    void grow(std::size_t span);
+};
@@ -5,7 +5,10 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <iostream>
 #include <string>
 
 
@@ -18,45 +21,56 @@ namespace SHADER
     constexpr std::uint32_t COLOR_VISITED   = 0xffff0000;
     constexpr std::uint32_t COLOR_PATH      = 0xff00a5ff;
 
+    // Terrain fades from sand at cost 2 to dark soil at the maximum cost.
+    constexpr glm::vec3 COLOR_TERRAIN_LOW   = {230.0f, 215.0f, 170.0f};
+    constexpr glm::vec3 COLOR_TERRAIN_HIGH  = {90.0f, 60.0f, 25.0f};
+
+    // Palette slots after the tile types, and the first tile value holding a terrain shade.
+    constexpr std::size_t PALETTE_TERRAIN_LOW   = 6;
+    constexpr std::size_t PALETTE_TERRAIN_HIGH  = 7;
+    constexpr std::size_t PALETTE_SIZE          = 8;
+    constexpr unsigned int TERRAIN_BASE         = 8;
+
 
     const std::string BUFFER_VERTEX = R"glsl(
 #version 450 core
 
 
-struct SSBData
-{
-    uint position;
-    uint color;
-};
+const uint TERRAIN_BASE = 8u;
 
 
 layout (location = 0) in vec2 vbo_position;
-layout (std430, binding = 0) readonly buffer ssbo
-{
-    SSBData ssbo_data[];
-};
+layout (binding = 0) uniform usampler2D tiles;
 
 
 uniform mat4 projection;
+uniform vec4 palette[8];
+// First visible texel, texels per visible row and the mip level drawn.
+uniform ivec4 view;
 
 
-flat out uint v_color;
-flat out vec2 v_local;
+flat out vec4 v_color;
+     out vec2 v_local;
 
 
 void main()
 {
-    SSBData data = ssbo_data[gl_InstanceID];
-
-    vec2 extracted_position;
-    extracted_position.x = bitfieldExtract(data.position, 16, 16);
-    extracted_position.y = bitfieldExtract(data.position,  0, 16);
+    ivec2 texel = view.xy + ivec2(gl_InstanceID % view.z, gl_InstanceID / view.z);
+    uint value = texelFetch(tiles, texel, view.w).r;
 
-    v_local = vbo_position * vec2(10, 10);
-    vec2 scaled_position = v_local + extracted_position;
+    v_local = vbo_position;
+    vec2 scaled_position = (vbo_position + vec2(texel.yx)) * float(10 << view.w);
 
     gl_Position = projection * vec4(scaled_position, 0.0, 1.0);
-    v_color = data.color;
+
+    if (value < TERRAIN_BASE)
+    {
+        v_color = palette[value];
+    }
+    else
+    {
+        v_color = mix(palette[6], palette[7], float(value - TERRAIN_BASE) / float(255u - TERRAIN_BASE));
+    }
 }
 )glsl";
 
@@ -68,24 +82,28 @@ void main()
 out vec4 frag_color;
 
 
-flat in uint v_color;
+// Share of a tile taken by its border, zero once tiles get too small to show one.
+uniform float border;
+
+
+flat in vec4 v_color;
      in vec2 v_local;
 
 
 void main()
 {
     bool is_border =
-        v_local.x <  1.0 ||
-        v_local.x >= 9.0 ||
-        v_local.y <  1.0 ||
-        v_local.y >= 9.0;
+        v_local.x <  border ||
+        v_local.x >= 1.0 - border ||
+        v_local.y <  border ||
+        v_local.y >= 1.0 - border;
 
     if (is_border) {
         frag_color = vec4(0.0, 0.0, 0.0, 1.0);
     }
     else
     {
-        frag_color = unpackUnorm4x8(v_color);
+        frag_color = v_color;
     }
 }
 )glsl";
@@ -94,59 +112,96 @@ void main()
 }
 
 
-static std::uint32_t packPosition(const glm::ivec2 &position)
+static constexpr GLuint64 FENCE_TIMEOUT_NS = 1'000'000;
+
+// Screen pixels a drawn texel should cover at least, and from which size on tiles get a border.
+static constexpr float MIN_TEXEL_PIXELS = 2.0f;
+static constexpr float MIN_BORDER_PIXELS = 4.0f;
+static constexpr float BORDER = 0.1f;
+
+
+static glm::vec4 unpackColor(const std::uint32_t color)
 {
-    return (static_cast<uint32_t>(position.x) & 0xFFFFu) << 16 |
-        (static_cast<uint32_t>(position.y) & 0xFFFFu);
+    return glm::vec4(
+        static_cast<float>(color & 0xff),
+        static_cast<float>(color >> 8 & 0xff),
+        static_cast<float>(color >> 16 & 0xff),
+        static_cast<float>(color >> 24 & 0xff)) / 255.0f;
 }
 
 
-static std::uint32_t colorFromType(const TileType type)
+static std::array<glm::vec4, SHADER::PALETTE_SIZE> palette()
 {
-    std::uint32_t color = 0xffffffff;
+    std::array<glm::vec4, SHADER::PALETTE_SIZE> colors = {};
+
+    colors[static_cast<std::size_t>(TileType::CLEAR)] = unpackColor(SHADER::COLOR_CLEAR);
+    colors[static_cast<std::size_t>(TileType::BLOCKED)] = unpackColor(SHADER::COLOR_BLOCKED);
+    colors[static_cast<std::size_t>(TileType::START)] = unpackColor(SHADER::COLOR_START);
+    colors[static_cast<std::size_t>(TileType::GOAL)] = unpackColor(SHADER::COLOR_GOAL);
+    colors[static_cast<std::size_t>(TileType::VISITED)] = unpackColor(SHADER::COLOR_VISITED);
+    colors[static_cast<std::size_t>(TileType::PATH)] = unpackColor(SHADER::COLOR_PATH);
+    colors[SHADER::PALETTE_TERRAIN_LOW] = glm::vec4(SHADER::COLOR_TERRAIN_LOW / 255.0f, 1.0f);
+    colors[SHADER::PALETTE_TERRAIN_HIGH] = glm::vec4(SHADER::COLOR_TERRAIN_HIGH / 255.0f, 1.0f);
+
+    return colors;
+}
+
 
-    switch (type)
+// Cost 2 to 255 spread over the shades from TERRAIN_BASE up, plain ground is a clear tile.
+static std::uint8_t valueFromCost(const unsigned int cost)
+{
+    if (cost <= 1)
     {
-        case TileType::CLEAR:
-            color = SHADER::COLOR_CLEAR;
-            break;
+        return static_cast<std::uint8_t>(TileType::CLEAR);
+    }
 
-        case TileType::BLOCKED:
-            color = SHADER::COLOR_BLOCKED;
-            break;
+    const unsigned int shade = (std::min(cost, 255u) - 2) * (255 - SHADER::TERRAIN_BASE) / 253;
 
-        case TileType::START:
-            color = SHADER::COLOR_START;
-            break;
+    return static_cast<std::uint8_t>(SHADER::TERRAIN_BASE + shade);
+}
 
-        case TileType::GOAL:
-            color = SHADER::COLOR_GOAL;
-            break;
 
-        case TileType::VISITED:
-            color = SHADER::COLOR_VISITED;
-            break;
+// Which value a summary keeps of the tiles it covers: the route and search state over walls, walls
+// over terrain, darker terrain over lighter and anything over clear ground.
+static unsigned int summaryRank(const std::uint8_t value)
+{
+    static constexpr std::array RANKS = {0u, 2u, 6u, 5u, 3u, 4u};
 
-        case TileType::PATH:
-            color = SHADER::COLOR_PATH;
-            break;
+    if (value < RANKS.size())
+    {
+        return RANKS[value] << 8;
     }
 
-    return color;
+    return 1u << 8 | value;
 }
 
 
-Buffer::Buffer(const Window &window):
+Buffer::Buffer(const Window &window, const glm::ivec2 &grid_size):
     m_shader(SHADER::BUFFER_VERTEX, SHADER::BUFFER_FRAGMENT),
     m_projection_scale(window.scale()),
-    m_projection_size(window.size())
+    m_projection_size(window.size()),
+    m_grid_size(grid_size),
+    m_chunk_count((grid_size + glm::ivec2(CHUNK_SIZE - 1)) / CHUNK_SIZE),
+    m_dirty_chunks(static_cast<std::size_t>(m_chunk_count.x) * static_cast<std::size_t>(m_chunk_count.y))
 {
     updateProjection();
-    m_ssb_data.reserve(GLOBAL::GRID_SIZE * GLOBAL::GRID_SIZE);
+
+    const std::array<glm::vec4, SHADER::PALETTE_SIZE> colors = palette();
+    m_shader.vec4("palette", colors);
+
+    // Levels are padded to whole chunks, so every level halves exactly and chunks stay aligned.
+    for (int level = 0; level < MAX_LEVELS; level++)
+    {
+        const glm::ivec2 size = m_chunk_count * (CHUNK_SIZE >> level);
+
+        m_levels.emplace_back(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y), static_cast<std::uint8_t>(TileType::CLEAR));
+        m_level_sizes.push_back(size);
+    }
 
     glCreateVertexArrays(1, &m_vao);
     glCreateBuffers(1, &m_vbo);
-    glCreateBuffers(1, &m_ssbo);
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_texture);
+    glCreateBuffers(1, &m_staging);
 
     constexpr std::array vertices = {
         0.0f, 0.0f,
@@ -162,26 +217,48 @@ Buffer::Buffer(const Window &window):
     glVertexArrayAttribBinding(m_vao, 0, 0);
     glEnableVertexArrayAttrib(m_vao, 0);
 
-    for (int i = 0; i < GLOBAL::GRID_SIZE; i++)
-    {
-        for (int j = 0; j < GLOBAL::GRID_SIZE; j++)
-        {
-            SSBData data = {};
-            data.position = packPosition({i * 10, j * 10});
-            data.color = SHADER::COLOR_CLEAR;
+    glTextureStorage2D(m_texture, MAX_LEVELS, GL_R8UI, m_level_sizes.front().x, m_level_sizes.front().y);
+    // Integer textures are incomplete with a linear filter, and texelFetch on them then reads zero.
+    glTextureParameteri(m_texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTextureParameteri(m_texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-            m_ssb_data.push_back(data);
-        }
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    constexpr auto staging_size = static_cast<GLsizeiptr>(SECTION_SIZE * SECTION_COUNT);
+
+    glNamedBufferStorage(m_staging, staging_size, nullptr, flags);
+    m_mapping = static_cast<std::byte *>(glMapNamedBufferRange(m_staging, 0, staging_size, flags));
+
+    if (m_mapping == nullptr)
+    {
+        std::cerr << "Unable to map the tile staging buffer, falling back to direct uploads\n";
     }
 
-    glNamedBufferData(m_ssbo, static_cast<GLsizeiptr>(m_ssb_data.size() * sizeof(SSBData)), m_ssb_data.data(), GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_ssbo);
+    // The texture starts out undefined, chunks are filled once they come into view.
+    for (std::size_t chunk = 0; chunk < m_dirty_chunks.size(); chunk++)
+    {
+        m_dirty_chunks.set(chunk);
+    }
+    m_dirty_count = m_dirty_chunks.size();
 }
 
 
 Buffer::~Buffer()
 {
-    glDeleteBuffers(1, &m_ssbo);
+    for (const GLsync fence : m_fences)
+    {
+        if (fence != nullptr)
+        {
+            glDeleteSync(fence);
+        }
+    }
+
+    if (m_mapping != nullptr)
+    {
+        glUnmapNamedBuffer(m_staging);
+    }
+
+    glDeleteBuffers(1, &m_staging);
+    glDeleteTextures(1, &m_texture);
     glDeleteBuffers(1, &m_vbo);
     glDeleteVertexArrays(1, &m_vao);
 }
@@ -189,9 +266,12 @@ Buffer::~Buffer()
 
 void Buffer::clear()
 {
-    for (unsigned int i = 0; i < m_ssb_data.size(); i++)
+    for (int y = 0; y < m_grid_size.y; y++)
     {
-        updateTile(i, TileType::CLEAR);
+        for (int x = 0; x < m_grid_size.x; x++)
+        {
+            setTile({x, y}, static_cast<std::uint8_t>(TileType::CLEAR));
+        }
     }
 }
 
@@ -203,48 +283,296 @@ void Buffer::updateScale(const glm::vec2 &scale)
 }
 
 
+void Buffer::camera(const glm::vec2 &offset, const float zoom)
+{
+    m_camera_offset = offset;
+    m_zoom = zoom;
+    updateProjection();
+}
+
+
 void Buffer::updateTile(const unsigned int index, const TileType type)
 {
-    if (index > m_ssb_data.size())
+    const auto width = static_cast<unsigned int>(m_grid_size.x);
+    if (index >= width * static_cast<unsigned int>(m_grid_size.y))
     {
         return;
     }
 
-    m_ssb_data[index].color = colorFromType(type);
+    setTile({static_cast<int>(index % width), static_cast<int>(index / width)}, static_cast<std::uint8_t>(type));
 }
 
 
 void Buffer::updateTile(const glm::ivec2 &position, const TileType type)
 {
-    if (position.x >= GLOBAL::GRID_SIZE || position.y >= GLOBAL::GRID_SIZE || position.x < 0 || position.y < 0)
+    if (position.x >= m_grid_size.x || position.y >= m_grid_size.y || position.x < 0 || position.y < 0)
     {
         return;
     }
 
-    const int index = position.x + position.y * GLOBAL::GRID_SIZE;
-    m_ssb_data[index].color = colorFromType(type);
+    setTile(position, static_cast<std::uint8_t>(type));
 }
 
 
-void Buffer::update() const
+void Buffer::updateCost(const glm::ivec2 &position, const unsigned int cost)
 {
-    glNamedBufferSubData(m_ssbo, 0, static_cast<GLsizeiptr>(m_ssb_data.size() * sizeof(SSBData)), m_ssb_data.data());
+    if (position.x >= m_grid_size.x || position.y >= m_grid_size.y || position.x < 0 || position.y < 0)
+    {
+        return;
+    }
+
+    setTile(position, valueFromCost(cost));
+}
+
+
+void Buffer::update()
+{
+    m_uploaded_bytes = 0;
+
+    if (m_dirty_count == 0)
+    {
+        return;
+    }
+
+    const View view = visibleTiles();
+    const glm::ivec2 first_chunk = view.first / CHUNK_SIZE;
+    const glm::ivec2 last_chunk = (view.last + glm::ivec2(CHUNK_SIZE - 1)) / CHUNK_SIZE;
+
+    m_section = (m_section + 1) % SECTION_COUNT;
+    std::size_t staged = 0;
+
+    if (m_mapping != nullptr)
+    {
+        waitFence(m_section);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // Chunks out of view stay dirty until the camera reaches them.
+    for (int y = first_chunk.y; y < last_chunk.y; y++)
+    {
+        for (int x = first_chunk.x; x < last_chunk.x; x++)
+        {
+            const std::size_t chunk = static_cast<std::size_t>(x) + static_cast<std::size_t>(y) * static_cast<std::size_t>(m_chunk_count.x);
+            if (!m_dirty_chunks.test(chunk))
+            {
+                continue;
+            }
+
+            summarize({x, y});
+            uploadChunk({x, y}, staged);
+
+            m_dirty_chunks.reset(chunk);
+            m_dirty_count--;
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    // The section may be written again once the GPU has copied it into the texture.
+    if (staged > 0)
+    {
+        m_fences[m_section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
 }
 
 
 void Buffer::render() const
 {
+    const int level = visibleLevel();
+    const int texel_size = 1 << level;
+    const View view = visibleTiles();
+
+    // Texels of the level covering the visible tiles.
+    const glm::ivec2 first = view.first / texel_size;
+    const glm::ivec2 last = glm::min((view.last + glm::ivec2(texel_size - 1)) / texel_size, m_level_sizes[static_cast<std::size_t>(level)]);
+    const glm::ivec2 count = glm::max(last - first, glm::ivec2(0));
+
+    if (count.x == 0 || count.y == 0)
+    {
+        return;
+    }
+
+    const bool border = static_cast<float>(GLOBAL::TILE_SIZE) * m_zoom >= MIN_BORDER_PIXELS && level == 0;
+
     m_shader.use();
+    m_shader.ivec4("view", {first.x, first.y, count.x, level});
+    m_shader.scalar("border", border ? BORDER : 0.0f);
+
+    glBindTextureUnit(0, m_texture);
     glBindVertexArray(m_vao);
-    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<int>(m_ssb_data.size()));
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, count.x * count.y);
+}
+
+
+std::size_t Buffer::uploadedBytes() const
+{
+    return m_uploaded_bytes;
 }
 
 
 void Buffer::updateProjection() const
 {
     const glm::vec2 scaled_size = glm::vec2(m_projection_size) * m_projection_scale;
-    const glm::mat4 projection = glm::ortho(0.0f, scaled_size.x, scaled_size.y, 0.0f, -1.0f, 1.0f);
+    glm::mat4 projection = glm::ortho(0.0f, scaled_size.x, scaled_size.y, 0.0f, -1.0f, 1.0f);
+    projection = glm::scale(projection, glm::vec3(m_zoom, m_zoom, 1.0f));
+    projection = glm::translate(projection, glm::vec3(-m_camera_offset.x, -m_camera_offset.y, 0.0f));
 
     m_shader.use();
     m_shader.mat4("projection", projection);
 }
+
+
+// Tiles are drawn transposed, a tile's row runs along the screen's x axis.
+Buffer::View Buffer::visibleTiles() const
+{
+    const glm::vec2 scaled_size = glm::vec2(m_projection_size) * m_projection_scale;
+    const glm::vec2 world_first = m_camera_offset / static_cast<float>(GLOBAL::TILE_SIZE);
+    const glm::vec2 world_last = (m_camera_offset + scaled_size / m_zoom) / static_cast<float>(GLOBAL::TILE_SIZE);
+
+    const glm::ivec2 first = {static_cast<int>(std::floor(world_first.y)), static_cast<int>(std::floor(world_first.x))};
+    const glm::ivec2 last = {static_cast<int>(std::ceil(world_last.y)), static_cast<int>(std::ceil(world_last.x))};
+
+    View view;
+    view.first = glm::clamp(first, glm::ivec2(0), m_grid_size);
+    view.last = glm::clamp(last, view.first, m_grid_size);
+
+    return view;
+}
+
+
+// The coarsest level whose texels still cover MIN_TEXEL_PIXELS on screen.
+int Buffer::visibleLevel() const
+{
+    const float tile_pixels = static_cast<float>(GLOBAL::TILE_SIZE) * m_zoom;
+    if (tile_pixels >= MIN_TEXEL_PIXELS)
+    {
+        return 0;
+    }
+
+    const auto level = static_cast<int>(std::ceil(std::log2(MIN_TEXEL_PIXELS / tile_pixels)));
+
+    return std::min(level, MAX_LEVELS - 1);
+}
+
+
+void Buffer::setTile(const glm::ivec2 &position, const std::uint8_t value)
+{
+    std::uint8_t &tile = m_levels.front()[static_cast<std::size_t>(position.x) + static_cast<std::size_t>(position.y) * static_cast<std::size_t>(m_level_sizes.front().x)];
+    if (tile == value)
+    {
+        return;
+    }
+
+    tile = value;
+
+    const glm::ivec2 chunk_position = position / CHUNK_SIZE;
+    const std::size_t chunk = static_cast<std::size_t>(chunk_position.x) + static_cast<std::size_t>(chunk_position.y) * static_cast<std::size_t>(m_chunk_count.x);
+
+    if (!m_dirty_chunks.test(chunk))
+    {
+        m_dirty_chunks.set(chunk);
+        m_dirty_count++;
+    }
+}
+
+
+// Rebuilds the coarser levels of one chunk from the tiles up.
+void Buffer::summarize(const glm::ivec2 &chunk)
+{
+    for (std::size_t level = 1; level < m_levels.size(); level++)
+    {
+        const std::vector<std::uint8_t> &below = m_levels[level - 1];
+        const glm::ivec2 below_size = m_level_sizes[level - 1];
+        std::vector<std::uint8_t> &texels = m_levels[level];
+        const glm::ivec2 size = m_level_sizes[level];
+
+        const glm::ivec2 first = chunk * (CHUNK_SIZE >> level);
+        const glm::ivec2 last = first + glm::ivec2(CHUNK_SIZE >> level);
+
+        for (int y = first.y; y < last.y; y++)
+        {
+            for (int x = first.x; x < last.x; x++)
+            {
+                std::uint8_t summary = static_cast<std::uint8_t>(TileType::CLEAR);
+
+                for (int below_y = 2 * y; below_y < 2 * y + 2; below_y++)
+                {
+                    for (int below_x = 2 * x; below_x < 2 * x + 2; below_x++)
+                    {
+                        const std::uint8_t value = below[static_cast<std::size_t>(below_x) + static_cast<std::size_t>(below_y) * static_cast<std::size_t>(below_size.x)];
+                        if (summaryRank(value) > summaryRank(summary))
+                        {
+                            summary = value;
+                        }
+                    }
+                }
+
+                texels[static_cast<std::size_t>(x) + static_cast<std::size_t>(y) * static_cast<std::size_t>(size.x)] = summary;
+            }
+        }
+    }
+}
+
+
+void Buffer::uploadChunk(const glm::ivec2 &chunk, std::size_t &staged)
+{
+    for (int level = 0; level < MAX_LEVELS; level++)
+    {
+        const int chunk_size = CHUNK_SIZE >> level;
+        uploadRectangle(level, chunk * chunk_size, glm::ivec2(chunk_size), staged);
+    }
+}
+
+
+// Goes through the staging section while it has room, straight from the level otherwise.
+void Buffer::uploadRectangle(const int level, const glm::ivec2 &offset, const glm::ivec2 &size, std::size_t &staged)
+{
+    const std::vector<std::uint8_t> &texels = m_levels[static_cast<std::size_t>(level)];
+    const auto width = static_cast<std::size_t>(m_level_sizes[static_cast<std::size_t>(level)].x);
+    const std::size_t first_texel = static_cast<std::size_t>(offset.x) + static_cast<std::size_t>(offset.y) * width;
+    const auto row_bytes = static_cast<std::size_t>(size.x);
+    const std::size_t byte_count = row_bytes * static_cast<std::size_t>(size.y);
+
+    if (m_mapping != nullptr && staged + byte_count <= SECTION_SIZE)
+    {
+        const std::size_t staging_offset = m_section * SECTION_SIZE + staged;
+        for (int row = 0; row < size.y; row++)
+        {
+            std::memcpy(m_mapping + staging_offset + static_cast<std::size_t>(row) * row_bytes, texels.data() + first_texel + static_cast<std::size_t>(row) * width, row_bytes);
+        }
+        staged += byte_count;
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_staging);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTextureSubImage2D(m_texture, level, offset.x, offset.y, size.x, size.y, GL_RED_INTEGER, GL_UNSIGNED_BYTE, reinterpret_cast<const void *>(staging_offset));
+    }
+    else
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(width));
+        glTextureSubImage2D(m_texture, level, offset.x, offset.y, size.x, size.y, GL_RED_INTEGER, GL_UNSIGNED_BYTE, texels.data() + first_texel);
+    }
+
+    m_uploaded_bytes += byte_count;
+}
+
+
+void Buffer::waitFence(const std::size_t section)
+{
+    if (m_fences[section] == nullptr)
+    {
+        return;
+    }
+
+    // Only the first wait flushes, an unsubmitted fence would never signal.
+    GLenum result = glClientWaitSync(m_fences[section], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        result = glClientWaitSync(m_fences[section], 0, FENCE_TIMEOUT_NS);
+    }
+
+    glDeleteSync(m_fences[section]);
+    m_fences[section] = nullptr;
+}
@@ -1,10 +1,14 @@
 #pragma once
 
 
+#include "bit_set.hpp"
 #include "shader.hpp"
 
 #include <glm/glm.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 
@@ -22,17 +26,17 @@ enum class TileType
 };
 
 
-struct SSBData
-{
-    std::uint32_t position;
-    std::uint32_t color;
-};
-
-
+// One byte per tile in an R8UI texture. Values below TERRAIN_BASE are a TileType, the rest a terrain
+// shade. The vertex shader places every instance from gl_InstanceID and looks its colour up in a
+// palette uniform.
+//
+// The map is split into CHUNK_SIZE square chunks. Only the tiles under the camera are drawn and only
+// dirty chunks under it are uploaded, so a frame costs as much as the screen shows. Every mip level
+// of the texture summarises 2x2 tiles of the one below, far out a chunk shrinks to a single texel.
 class Buffer
 {
 public:
-    explicit Buffer(const Window &window);
+    Buffer(const Window &window, const glm::ivec2 &grid_size);
     Buffer(Buffer &) = delete;
     ~Buffer();
 
@@ -41,25 +45,73 @@ public:
     void clear();
 
     void updateScale(const glm::vec2 &scale);
+    // World pixels scrolled past the top left corner, and screen pixels per world pixel.
+    void camera(const glm::vec2 &offset, float zoom);
     void updateTile(unsigned int index, TileType type);
     void updateTile(const glm::ivec2 &position, TileType type);
+    void updateCost(const glm::ivec2 &position, unsigned int cost);
 
-    void update() const;
+    // Uploads the visible chunks changed since the last call, nothing on idle frames.
+    void update();
     void render() const;
 
+    [[nodiscard]] std::size_t uploadedBytes() const;
+
 
 private:
+    static constexpr int CHUNK_SIZE = 64;
+    // Down to one texel per chunk.
+    static constexpr int MAX_LEVELS = 7;
+    // Staging sections of the persistently mapped unpack buffer, the GPU may still read the other two.
+    static constexpr std::size_t SECTION_COUNT = 3;
+    static constexpr std::size_t SECTION_SIZE = std::size_t{1} << 22;
+
+
+    // Tile range under the camera, first inclusive and last exclusive.
+    struct View
+    {
+        glm::ivec2 first;
+        glm::ivec2 last;
+    };
+
+
     GLuint m_vao;
     GLuint m_vbo;
-    GLuint m_ssbo;
+    GLuint m_texture;
+    GLuint m_staging;
 
     Shader m_shader;
 
     glm::vec2 m_projection_scale;
     glm::ivec2 m_projection_size;
+    glm::ivec2 m_grid_size;
+
+    glm::vec2 m_camera_offset = {0.0f, 0.0f};
+    float m_zoom = 1.0f;
+
+    // Level 0 holds the tiles, every further level the summaries of the one below. Rows are padded
+    // to whole chunks.
+    std::vector<std::vector<std::uint8_t>> m_levels;
+    std::vector<glm::ivec2> m_level_sizes;
+
+    // Null if the staging buffer could not be mapped, every upload then reads from m_levels.
+    std::byte *m_mapping = nullptr;
+    std::size_t m_section = 0;
+    std::array<GLsync, SECTION_COUNT> m_fences = {};
 
-    std::vector<SSBData> m_ssb_data;
+    glm::ivec2 m_chunk_count;
+    BitSet m_dirty_chunks;
+    std::size_t m_dirty_count = 0;
+    std::size_t m_uploaded_bytes = 0;
 
 
     void updateProjection() const;
+    [[nodiscard]] View visibleTiles() const;
+    [[nodiscard]] int visibleLevel() const;
+
+    void setTile(const glm::ivec2 &position, std::uint8_t value);
+    void summarize(const glm::ivec2 &chunk);
+    void uploadChunk(const glm::ivec2 &chunk, std::size_t &staged);
+    void uploadRectangle(int level, const glm::ivec2 &offset, const glm::ivec2 &size, std::size_t &staged);
+    void waitFence(std::size_t section);
 };
@@ -0,0 +1,281 @@
+#include "component_index.hpp"
+
+#include <array>
+#include <utility>
+
+
+static constexpr std::array DIRECTIONS = {
+        glm::ivec2(0, 1),
+        glm::ivec2(1, 0),
+        glm::ivec2(0, -1),
+        glm::ivec2(-1, 0)
+};
+
+
+// The eight tiles around a tile in circular order, every tile is 4-adjacent to the next one.
+static constexpr std::array RING = {
+        glm::ivec2(0, -1),
+        glm::ivec2(1, -1),
+        glm::ivec2(1, 0),
+        glm::ivec2(1, 1),
+        glm::ivec2(0, 1),
+        glm::ivec2(-1, 1),
+        glm::ivec2(-1, 0),
+        glm::ivec2(-1, -1)
+};
+
+
+ComponentIndex::ComponentIndex(Grid &grid):
+    m_grid(grid)
+{
+    m_grid.listen(this);
+}
+
+
+ComponentIndex::~ComponentIndex()
+{
+    m_grid.unlisten(this);
+}
+
+
+void ComponentIndex::rebuild()
+{
+    m_labels.assign(m_grid.tileCount(), NONE);
+    m_parents.clear();
+    m_sizes.clear();
+
+    for (std::uint32_t index = 0; index < m_grid.tileCount(); index++)
+    {
+        if (m_grid.blocked(index) || m_labels[index] != NONE)
+        {
+            continue;
+        }
+
+        const auto label = static_cast<std::uint32_t>(m_parents.size());
+
+        m_queue.clear();
+        m_queue.push_back(index);
+        m_labels[index] = label;
+
+        for (std::size_t head = 0; head < m_queue.size(); head++)
+        {
+            const glm::ivec2 current_position = m_grid.position(m_queue[head]);
+
+            for (const glm::ivec2 &offset : DIRECTIONS)
+            {
+                const glm::ivec2 neighbour_position = current_position + offset;
+                if (!m_grid.contains(neighbour_position))
+                {
+                    continue;
+                }
+
+                const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+                if (!m_grid.blocked(neighbour_index) && m_labels[neighbour_index] == NONE)
+                {
+                    m_labels[neighbour_index] = label;
+                    m_queue.push_back(neighbour_index);
+                }
+            }
+        }
+
+        m_parents.push_back(label);
+        m_sizes.push_back(static_cast<std::uint32_t>(m_queue.size()));
+    }
+
+    m_component_count = m_parents.size();
+    m_dirty = false;
+}
+
+
+void ComponentIndex::update()
+{
+    if (m_dirty)
+    {
+        rebuild();
+    }
+}
+
+
+bool ComponentIndex::dirty() const
+{
+    return m_dirty;
+}
+
+
+bool ComponentIndex::connected(const glm::ivec2 &start, const glm::ivec2 &goal) const
+{
+    if (!m_grid.contains(start) || !m_grid.contains(goal))
+    {
+        return false;
+    }
+
+    if (m_labels.empty())
+    {
+        return true;
+    }
+
+    const std::uint32_t start_label = m_labels[m_grid.index(start)];
+    const std::uint32_t goal_label = m_labels[m_grid.index(goal)];
+
+    // A blocked goal is never entered, a blocked start may still be left by a search.
+    if (goal_label == NONE)
+    {
+        return false;
+    }
+
+    return start_label == NONE || find(start_label) == find(goal_label);
+}
+
+
+// Exact while the index is not dirty, a pending split is only counted by the next update().
+std::size_t ComponentIndex::componentCount() const
+{
+    return m_component_count;
+}
+
+
+void ComponentIndex::tileChanged(const glm::ivec2 &position)
+{
+    if (m_labels.empty())
+    {
+        return;
+    }
+
+    const std::uint32_t index = m_grid.index(position);
+    const bool blocked = m_grid.blocked(index);
+
+    // Terrain edits keep the tile as it was.
+    if (blocked && m_labels[index] != NONE)
+    {
+        tileBlocked(position);
+    }
+    else if (!blocked && m_labels[index] == NONE)
+    {
+        tileUnblocked(position);
+    }
+}
+
+
+void ComponentIndex::gridChanged()
+{
+    // The old labels would separate tiles that may be connected now.
+    m_labels.clear();
+    m_parents.clear();
+    m_sizes.clear();
+    m_component_count = 0;
+    m_dirty = true;
+}
+
+
+std::uint32_t ComponentIndex::find(std::uint32_t label) const
+{
+    // Union by size keeps the trees logarithmic, so lookups stay const without path compression.
+    while (m_parents[label] != label)
+    {
+        label = m_parents[label];
+    }
+
+    return label;
+}
+
+
+// Whether the free tiles around a newly blocked tile could have been connected only through it.
+// They are safe if all of its free orthogonal neighbours lie on one free run of the surrounding ring.
+bool ComponentIndex::mayDisconnect(const glm::ivec2 &position) const
+{
+    std::array<bool, RING.size()> free = {};
+    for (std::size_t i = 0; i < RING.size(); i++)
+    {
+        const glm::ivec2 neighbour_position = position + RING[i];
+        free[i] = m_grid.contains(neighbour_position) && !m_grid.blocked(neighbour_position);
+    }
+
+    int runs = 0;
+    for (std::size_t i = 0; i < RING.size(); i++)
+    {
+        if (!free[i] || free[(i + RING.size() - 1) % RING.size()])
+        {
+            continue;
+        }
+
+        // Count the run starting here if it touches an orthogonal neighbour, those sit at even positions.
+        bool orthogonal = false;
+        for (std::size_t j = i; free[j % RING.size()] && j < i + RING.size(); j++)
+        {
+            orthogonal = orthogonal || j % 2 == 0;
+        }
+
+        runs += orthogonal;
+    }
+
+    return runs > 1;
+}
+
+
+void ComponentIndex::join(const std::uint32_t first, const std::uint32_t second)
+{
+    std::uint32_t first_root = find(first);
+    std::uint32_t second_root = find(second);
+
+    if (first_root == second_root)
+    {
+        return;
+    }
+
+    if (m_sizes[first_root] < m_sizes[second_root])
+    {
+        std::swap(first_root, second_root);
+    }
+
+    m_parents[second_root] = first_root;
+    m_sizes[first_root] += m_sizes[second_root];
+    m_component_count--;
+}
+
+
+void ComponentIndex::tileBlocked(const glm::ivec2 &position)
+{
+    m_labels[m_grid.index(position)] = NONE;
+
+    bool isolated = true;
+    for (const glm::ivec2 &offset : DIRECTIONS)
+    {
+        const glm::ivec2 neighbour_position = position + offset;
+        isolated = isolated && (!m_grid.contains(neighbour_position) || m_grid.blocked(neighbour_position));
+    }
+
+    if (isolated)
+    {
+        m_component_count--;
+    }
+    else if (mayDisconnect(position))
+    {
+        m_dirty = true;
+    }
+}
+
+
+void ComponentIndex::tileUnblocked(const glm::ivec2 &position)
+{
+    const auto label = static_cast<std::uint32_t>(m_parents.size());
+
+    m_labels[m_grid.index(position)] = label;
+    m_parents.push_back(label);
+    m_sizes.push_back(1);
+    m_component_count++;
+
+    for (const glm::ivec2 &offset : DIRECTIONS)
+    {
+        const glm::ivec2 neighbour_position = position + offset;
+        if (!m_grid.contains(neighbour_position))
+        {
+            continue;
+        }
+
+        const std::uint32_t neighbour_label = m_labels[m_grid.index(neighbour_position)];
+        if (neighbour_label != NONE)
+        {
+            join(label, neighbour_label);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+
+#include "grid.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+// Connected components of the free tiles of a 4-connected grid, so unreachable queries are rejected
+// before a search floods the start's whole region. Unblocking a tile joins the components around it
+// in a union-find. Blocking one can only split, the old labels still never separate connected tiles,
+// so the split is relabelled lazily by the next update(). A local check around the tile skips the
+// relabel when the tile cannot have cut anything.
+class ComponentIndex final : public GridListener
+{
+public:
+    explicit ComponentIndex(Grid &grid);
+    ComponentIndex(const ComponentIndex &) = delete;
+    ~ComponentIndex() override;
+
+    void operator=(const ComponentIndex &) = delete;
+
+    void rebuild();
+    void update();
+    [[nodiscard]] bool dirty() const;
+
+    // False only if no path can exist. Until the first rebuild every pair counts as connected.
+    [[nodiscard]] bool connected(const glm::ivec2 &start, const glm::ivec2 &goal) const;
+    [[nodiscard]] std::size_t componentCount() const;
+
+    void tileChanged(const glm::ivec2 &position) override;
+    void gridChanged() override;
+
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+
+    Grid &m_grid;
+
+    // Component of every free tile, NONE for blocked ones. Unblocked tiles get fresh components,
+    // so labels are union-find nodes rather than final ids.
+    std::vector<std::uint32_t> m_labels;
+    std::vector<std::uint32_t> m_parents;
+    std::vector<std::uint32_t> m_sizes;
+    std::size_t m_component_count = 0;
+
+    std::vector<std::uint32_t> m_queue;
+    bool m_dirty = true;
+
+
+    [[nodiscard]] std::uint32_t find(std::uint32_t label) const;
+    [[nodiscard]] bool mayDisconnect(const glm::ivec2 &position) const;
+
+    void join(std::uint32_t first, std::uint32_t second);
+    void tileBlocked(const glm::ivec2 &position);
+    void tileUnblocked(const glm::ivec2 &position);
+};
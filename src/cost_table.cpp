@@ -0,0 +1,54 @@
+#include "cost_table.hpp"
+
+#include <algorithm>
+
+
+void CostTable::resize(const std::size_t size)
+{
+    m_entries.assign(size, {UNREACHED, 0});
+    m_generation = 2;
+}
+
+
+void CostTable::reset()
+{
+    m_generation += 2;
+
+    if (m_generation >= UINT32_MAX - 1) [[unlikely]]
+    {
+        std::ranges::fill(m_entries, Entry{UNREACHED, 0});
+        m_generation = 2;
+    }
+}
+
+
+std::size_t CostTable::size() const
+{
+    return m_entries.size();
+}
+
+
+unsigned int CostTable::cost(const std::size_t index) const
+{
+    const Entry &entry = m_entries[index];
+
+    return entry.stamp - m_generation <= 1 ? entry.cost : UNREACHED;
+}
+
+
+void CostTable::cost(const std::size_t index, const unsigned int cost)
+{
+    m_entries[index] = {cost, m_generation};
+}
+
+
+bool CostTable::closed(const std::size_t index) const
+{
+    return m_entries[index].stamp == m_generation + 1;
+}
+
+
+void CostTable::close(const std::size_t index)
+{
+    m_entries[index].stamp = m_generation + 1;
+}
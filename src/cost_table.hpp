@@ -0,0 +1,38 @@
+#pragma once
+
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+
+class CostTable
+{
+public:
+    static constexpr unsigned int UNREACHED = UINT_MAX;
+
+
+    void resize(std::size_t size);
+    void reset();
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] unsigned int cost(std::size_t index) const;
+    void cost(std::size_t index, unsigned int cost);
+
+    [[nodiscard]] bool closed(std::size_t index) const;
+    void close(std::size_t index);
+
+
+private:
+    struct Entry
+    {
+        unsigned int cost;
+        std::uint32_t stamp;
+    };
+
+
+    // Entries are valid only if their stamp matches the current generation (open)
+    // or the generation after it (closed), so reset() never touches the table.
+    std::vector<Entry> m_entries;
+    std::uint32_t m_generation = 2;
+};
@@ -0,0 +1,307 @@
+#include "distance_field.hpp"
+
+#include <algorithm>
+#include <array>
+
+
+static constexpr std::array DIRECTIONS = {
+        glm::ivec2(0, 1),
+        glm::ivec2(1, 0),
+        glm::ivec2(0, -1),
+        glm::ivec2(-1, 0)
+};
+
+
+// Smaller buckets are relaxed on the calling thread, handing them out costs more than it saves.
+static constexpr std::size_t PARALLEL_BUCKET_SIZE = 4096;
+static constexpr std::size_t CHUNKS_PER_THREAD = 4;
+static constexpr int ROWS_PER_TASK = 32;
+
+
+DistanceField::DistanceField(Grid &grid, const unsigned int thread_count):
+    m_grid(grid),
+    m_pool(thread_count)
+{
+    m_grid.listen(this);
+}
+
+
+DistanceField::~DistanceField()
+{
+    m_grid.unlisten(this);
+}
+
+
+void DistanceField::build(const std::span<const glm::ivec2> goals)
+{
+    m_goals.assign(goals.begin(), goals.end());
+    m_distances.assign(m_grid.tileCount(), UNREACHED);
+    m_directions.assign(m_grid.tileCount(), NO_DIRECTION);
+    m_dirty = false;
+
+    // A step costs at least the cheapest and at most the dearest terrain, so it lands between one
+    // and largest / width + 1 buckets further on and the ring never wraps onto unfinished work.
+    m_bucket_width = m_grid.minimumCost();
+    const unsigned int largest = m_grid.uniformCost() ? m_bucket_width : UINT8_MAX;
+    const std::size_t ring_size = largest / m_bucket_width + 2;
+
+    m_buckets.resize(ring_size);
+    for (std::vector<std::vector<Entry>> &bucket : m_buckets)
+    {
+        bucket.resize(m_pool.threadCount() + 1);
+        for (std::vector<Entry> &list : bucket)
+        {
+            list.clear();
+        }
+    }
+    m_queued = 0;
+
+    const unsigned int caller = m_pool.threadCount();
+
+    for (const glm::ivec2 &goal : m_goals)
+    {
+        if (!m_grid.contains(goal) || m_grid.blocked(goal))
+        {
+            continue;
+        }
+
+        const std::uint32_t index = m_grid.index(goal);
+        if (m_distances[index] != 0)
+        {
+            m_distances[index] = 0;
+            m_buckets[0][caller].push_back({index, 0});
+            m_queued++;
+        }
+    }
+
+    for (std::size_t bucket = 0; m_queued > 0; bucket = (bucket + 1) % ring_size)
+    {
+        relaxBucket(bucket);
+    }
+
+    for (int row = 0; row < m_grid.height(); row += ROWS_PER_TASK)
+    {
+        const int last_row = std::min(row + ROWS_PER_TASK, m_grid.height()) - 1;
+        m_pool.submit([this, row, last_row](unsigned int)
+        {
+            findDirections(row, last_row);
+        });
+    }
+    m_pool.wait();
+}
+
+
+void DistanceField::update()
+{
+    if (m_dirty)
+    {
+        build(m_goals);
+    }
+}
+
+
+bool DistanceField::dirty() const
+{
+    return m_dirty;
+}
+
+
+std::span<const glm::ivec2> DistanceField::goals() const
+{
+    return m_goals;
+}
+
+
+unsigned int DistanceField::distance(const glm::ivec2 &position) const
+{
+    if (!m_grid.contains(position) || m_distances.empty())
+    {
+        return UNREACHED;
+    }
+
+    return m_distances[m_grid.index(position)];
+}
+
+
+std::optional<glm::ivec2> DistanceField::next(const glm::ivec2 &position) const
+{
+    if (!m_grid.contains(position) || m_directions.empty())
+    {
+        return std::nullopt;
+    }
+
+    const std::uint8_t direction = m_directions[m_grid.index(position)];
+    if (direction == NO_DIRECTION)
+    {
+        return std::nullopt;
+    }
+
+    return position + DIRECTIONS[direction];
+}
+
+
+PathResult DistanceField::path(const glm::ivec2 &start) const
+{
+    PathResult result;
+
+    if (distance(start) == UNREACHED)
+    {
+        return result;
+    }
+
+    result.path.push_back(start);
+    for (std::optional<glm::ivec2> position = next(start); position; position = next(*position))
+    {
+        result.path.push_back(*position);
+    }
+
+    result.cost = distance(start);
+    result.found = true;
+
+    return result;
+}
+
+
+unsigned int DistanceField::threadCount() const
+{
+    return m_pool.threadCount();
+}
+
+
+void DistanceField::tileChanged([[maybe_unused]] const glm::ivec2 &position)
+{
+    m_dirty = true;
+}
+
+
+void DistanceField::gridChanged()
+{
+    m_dirty = true;
+}
+
+
+// The field runs from the goals outwards, a neighbour reaches this tile by paying for entering it.
+void DistanceField::relax(const Entry &entry, const unsigned int worker)
+{
+    // A tile queued again with a lower cost leaves its old entry behind.
+    if (std::atomic_ref(m_distances[entry.index]).load(std::memory_order_relaxed) != entry.distance)
+    {
+        return;
+    }
+
+    const glm::ivec2 position = m_grid.position(entry.index);
+    const unsigned int new_distance = entry.distance + m_grid.cost(entry.index);
+    const std::size_t bucket = new_distance / m_bucket_width % m_buckets.size();
+
+    for (const glm::ivec2 &offset : DIRECTIONS)
+    {
+        const glm::ivec2 neighbour_position = position + offset;
+        if (!m_grid.contains(neighbour_position))
+        {
+            continue;
+        }
+
+        const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+        if (m_grid.blocked(neighbour_index))
+        {
+            continue;
+        }
+
+        std::atomic_ref distance(m_distances[neighbour_index]);
+        unsigned int old_distance = distance.load(std::memory_order_relaxed);
+
+        while (new_distance < old_distance && !distance.compare_exchange_weak(old_distance, new_distance, std::memory_order_relaxed))
+        {
+        }
+
+        if (new_distance < old_distance)
+        {
+            m_buckets[bucket][worker].push_back({neighbour_index, new_distance});
+            m_queued.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+void DistanceField::relaxBucket(const std::size_t bucket)
+{
+    m_current.clear();
+    for (std::vector<Entry> &list : m_buckets[bucket])
+    {
+        m_current.insert(m_current.end(), list.begin(), list.end());
+        list.clear();
+    }
+
+    if (m_current.empty())
+    {
+        return;
+    }
+
+    m_queued.fetch_sub(m_current.size(), std::memory_order_relaxed);
+
+    if (m_current.size() < PARALLEL_BUCKET_SIZE || m_pool.threadCount() == 1)
+    {
+        for (const Entry &entry : m_current)
+        {
+            relax(entry, m_pool.threadCount());
+        }
+        return;
+    }
+
+    const std::size_t chunk_size = (m_current.size() + m_pool.threadCount() * CHUNKS_PER_THREAD - 1) / (m_pool.threadCount() * CHUNKS_PER_THREAD);
+
+    for (std::size_t begin = 0; begin < m_current.size(); begin += chunk_size)
+    {
+        const std::size_t end = std::min(begin + chunk_size, m_current.size());
+
+        m_pool.submit([this, begin, end](const unsigned int worker)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                relax(m_current[i], worker);
+            }
+        });
+    }
+
+    m_pool.wait();
+}
+
+
+void DistanceField::findDirections(const int first_row, const int last_row)
+{
+    for (int y = first_row; y <= last_row; y++)
+    {
+        for (int x = 0; x < m_grid.width(); x++)
+        {
+            const std::uint32_t index = m_grid.index({x, y});
+            if (m_distances[index] == 0 || m_distances[index] == UNREACHED)
+            {
+                continue;
+            }
+
+            unsigned int best = UNREACHED;
+
+            for (std::size_t direction = 0; direction < DIRECTIONS.size(); direction++)
+            {
+                const glm::ivec2 neighbour_position = glm::ivec2(x, y) + DIRECTIONS[direction];
+                if (!m_grid.contains(neighbour_position))
+                {
+                    continue;
+                }
+
+                const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+                if (m_grid.blocked(neighbour_index) || m_distances[neighbour_index] == UNREACHED)
+                {
+                    continue;
+                }
+
+                const unsigned int cost = m_distances[neighbour_index] + m_grid.cost(neighbour_index);
+                if (cost < best)
+                {
+                    best = cost;
+                    m_directions[index] = static_cast<std::uint8_t>(direction);
+                }
+            }
+        }
+    }
+}
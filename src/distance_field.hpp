@@ -0,0 +1,85 @@
+#pragma once
+
+
+#include "cost_table.hpp"
+#include "grid.hpp"
+#include "search.hpp"
+#include "thread_pool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+// Cost from every tile of a 4-connected grid to the closest of one or more goals, plus the step each
+// tile takes towards it, so any number of agents sharing the goals read their next move in O(1).
+//
+// The field is built by a bucketed Dijkstra whose bucket width is the cheapest terrain cost. No edge
+// is shorter than a bucket, so all tiles of a bucket are final together and large buckets are
+// relaxed by the pool workers in parallel. Every edit marks the field dirty, update() rebuilds it
+// for the same goals.
+//
+// The viewer's flow field mode uses it for 4-connected searches only.
+class DistanceField final : public GridListener
+{
+public:
+    static constexpr unsigned int UNREACHED = CostTable::UNREACHED;
+
+
+    explicit DistanceField(Grid &grid, unsigned int thread_count = std::thread::hardware_concurrency());
+    DistanceField(const DistanceField &) = delete;
+    ~DistanceField() override;
+
+    void operator=(const DistanceField &) = delete;
+
+    void build(std::span<const glm::ivec2> goals);
+    void update();
+    [[nodiscard]] bool dirty() const;
+    [[nodiscard]] std::span<const glm::ivec2> goals() const;
+
+    [[nodiscard]] unsigned int distance(const glm::ivec2 &position) const;
+    // Neighbour to move to, none on a goal and on tiles that cannot reach one.
+    [[nodiscard]] std::optional<glm::ivec2> next(const glm::ivec2 &position) const;
+    // Follows the steps from start to the closest goal.
+    [[nodiscard]] PathResult path(const glm::ivec2 &start) const;
+
+    [[nodiscard]] unsigned int threadCount() const;
+
+    void tileChanged(const glm::ivec2 &position) override;
+    void gridChanged() override;
+
+
+private:
+    static constexpr std::uint8_t NO_DIRECTION = UINT8_MAX;
+
+
+    struct Entry
+    {
+        std::uint32_t index;
+        unsigned int distance;
+    };
+
+
+    Grid &m_grid;
+    ThreadPool m_pool;
+
+    std::vector<glm::ivec2> m_goals;
+    std::vector<unsigned int> m_distances;
+    std::vector<std::uint8_t> m_directions;
+    bool m_dirty = true;
+
+    unsigned int m_bucket_width = 1;
+    // Ring of buckets, every bucket holds one list per pool worker and one for the calling thread.
+    std::vector<std::vector<std::vector<Entry>>> m_buckets;
+    std::vector<Entry> m_current;
+    std::atomic<std::size_t> m_queued = 0;
+
+
+    void relax(const Entry &entry, unsigned int worker);
+    void relaxBucket(std::size_t bucket);
+    void findDirections(int first_row, int last_row);
+};
@@ -0,0 +1,162 @@
+#include "generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+
+void fillNoise(Grid &grid, int percentage, const std::uint32_t seed)
+{
+    percentage = std::clamp(percentage, 0, 100);
+
+    const long long blocked_count = static_cast<long long>(grid.tileCount()) * percentage / 100;
+
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution distribution_x(0, grid.width() - 1);
+    std::uniform_int_distribution distribution_y(0, grid.height() - 1);
+
+    for (long long i = 0; i < blocked_count; i++)
+    {
+        const int x = distribution_x(generator);
+        const int y = distribution_y(generator);
+
+        grid.block({x, y});
+    }
+}
+
+
+// Scatters rectangular patches of mud, water and the like over the map, everything else stays at cost 1.
+void fillTerrain(Grid &grid, const std::uint8_t maximum_cost, const std::uint32_t seed)
+{
+    if (maximum_cost < 2)
+    {
+        return;
+    }
+
+    const int patch_size = std::max(2, std::min(grid.width(), grid.height()) / 8);
+    const unsigned int patch_count = grid.tileCount() / static_cast<unsigned int>(patch_size * patch_size) + 1;
+
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution distribution_x(0, grid.width() - 1);
+    std::uniform_int_distribution distribution_y(0, grid.height() - 1);
+    std::uniform_int_distribution distribution_size(1, patch_size);
+    std::uniform_int_distribution<unsigned int> distribution_cost(2, maximum_cost);
+
+    for (unsigned int i = 0; i < patch_count; i++)
+    {
+        const glm::ivec2 corner(distribution_x(generator), distribution_y(generator));
+        const glm::ivec2 size(distribution_size(generator), distribution_size(generator));
+        const auto cost = static_cast<std::uint8_t>(distribution_cost(generator));
+
+        for (int y = corner.y; y < std::min(corner.y + size.y, grid.height()); y++)
+        {
+            for (int x = corner.x; x < std::min(corner.x + size.x, grid.width()); x++)
+            {
+                grid.cost({x, y}, cost);
+            }
+        }
+    }
+}
+
+
+// Recursive backtracker on the odd tiles, walls are carved between neighbouring cells.
+Grid generateMaze(const int width, const int height, const std::uint32_t seed)
+{
+    Grid grid(width, height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            grid.block({x, y});
+        }
+    }
+
+    if (width < 3 || height < 3)
+    {
+        return grid;
+    }
+
+    constexpr std::array directions = {
+        glm::ivec2(2, 0),
+        glm::ivec2(-2, 0),
+        glm::ivec2(0, 2),
+        glm::ivec2(0, -2)
+    };
+
+    std::mt19937 generator(seed);
+    std::vector<glm::ivec2> stack = {{1, 1}};
+    grid.unblock({1, 1});
+
+    while (!stack.empty())
+    {
+        const glm::ivec2 current = stack.back();
+
+        std::array<glm::ivec2, 4> options = {};
+        std::size_t option_count = 0;
+
+        for (const glm::ivec2 &direction : directions)
+        {
+            const glm::ivec2 next = current + direction;
+            if (next.x >= 1 && next.y >= 1 && next.x < width - 1 && next.y < height - 1 && grid.blocked(next))
+            {
+                options[option_count++] = direction;
+            }
+        }
+
+        if (option_count == 0)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const glm::ivec2 direction = options[generator() % option_count];
+        grid.unblock(current + direction / 2);
+        grid.unblock(current + direction);
+        stack.push_back(current + direction);
+    }
+
+    return grid;
+}
+
+
+// Square rooms separated by one tile thick walls, every wall segment gets a door at a random spot.
+Grid generateRooms(const int width, const int height, const int room_size, const std::uint32_t seed)
+{
+    Grid grid(width, height);
+
+    if (room_size < 2)
+    {
+        return grid;
+    }
+
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution door(1, room_size - 1);
+
+    for (int y = room_size; y < height; y += room_size)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            grid.block({x, y});
+        }
+        for (int x = 0; x < width; x += room_size)
+        {
+            grid.unblock({x + door(generator), y});
+        }
+    }
+
+    for (int x = room_size; x < width; x += room_size)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            grid.block({x, y});
+        }
+        for (int y = 0; y < height; y += room_size)
+        {
+            grid.unblock({x, y + door(generator)});
+        }
+    }
+
+    return grid;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+
+#include "grid.hpp"
+
+#include <cstdint>
+
+
+void fillNoise(Grid &grid, int percentage, std::uint32_t seed);
+void fillTerrain(Grid &grid, std::uint8_t maximum_cost, std::uint32_t seed);
+
+[[nodiscard]] Grid generateMaze(int width, int height, std::uint32_t seed);
+[[nodiscard]] Grid generateRooms(int width, int height, int room_size, std::uint32_t seed);
@@ -0,0 +1,194 @@
+#include "grid.hpp"
+
+#include <iostream>
+
+
+Grid::Grid(const int width, const int height):
+    m_width(width),
+    m_height(height),
+    m_blocked_tiles(static_cast<std::size_t>(width) * static_cast<std::size_t>(height))
+{
+}
+
+
+bool Grid::blocked(const unsigned int index) const
+{
+    return m_blocked_tiles.test(index);
+}
+
+
+bool Grid::blocked(const glm::ivec2 &position) const
+{
+    return m_blocked_tiles.test(index(position));
+}
+
+
+bool Grid::contains(const glm::ivec2 &position) const
+{
+    return position.x >= 0 && position.y >= 0 && position.x < m_width && position.y < m_height;
+}
+
+
+unsigned int Grid::index(const glm::ivec2 &position) const
+{
+    return static_cast<unsigned int>(position.x) + static_cast<unsigned int>(position.y) * static_cast<unsigned int>(m_width);
+}
+
+
+glm::ivec2 Grid::position(const unsigned int index) const
+{
+    const auto width = static_cast<unsigned int>(m_width);
+
+    return {static_cast<int>(index % width), static_cast<int>(index / width)};
+}
+
+
+int Grid::width() const
+{
+    return m_width;
+}
+
+
+int Grid::height() const
+{
+    return m_height;
+}
+
+
+unsigned int Grid::tileCount() const
+{
+    return static_cast<unsigned int>(m_width) * static_cast<unsigned int>(m_height);
+}
+
+
+unsigned int Grid::cost(const unsigned int index) const
+{
+    return m_costs.empty() ? 1 : m_costs[index];
+}
+
+
+unsigned int Grid::cost(const glm::ivec2 &position) const
+{
+    return cost(index(position));
+}
+
+
+void Grid::cost(const glm::ivec2 &position, const std::uint8_t cost)
+{
+    if (cost == 0)
+    {
+        std::cerr << "Terrain cost has to be at least 1\n";
+        return;
+    }
+
+    if (!contains(position) || this->cost(position) == cost)
+    {
+        return;
+    }
+
+    if (m_costs.empty())
+    {
+        m_costs.assign(tileCount(), 1);
+        m_cost_counts[1] = tileCount();
+    }
+
+    std::uint8_t &tile_cost = m_costs[index(position)];
+    m_cost_counts[tile_cost]--;
+    m_cost_counts[cost]++;
+    tile_cost = cost;
+    m_version++;
+
+    for (GridListener *listener : m_listeners)
+    {
+        listener->tileChanged(position);
+    }
+}
+
+
+unsigned int Grid::minimumCost() const
+{
+    if (m_costs.empty())
+    {
+        return 1;
+    }
+
+    unsigned int cost = 1;
+    while (m_cost_counts[cost] == 0)
+    {
+        cost++;
+    }
+
+    return cost;
+}
+
+
+bool Grid::uniformCost() const
+{
+    return m_costs.empty() || m_cost_counts[minimumCost()] == tileCount();
+}
+
+
+void Grid::block(const glm::ivec2 &position)
+{
+    if (!contains(position) || m_blocked_tiles.test(index(position)))
+    {
+        return;
+    }
+
+    m_blocked_tiles.set(index(position));
+    m_version++;
+
+    for (GridListener *listener : m_listeners)
+    {
+        listener->tileChanged(position);
+    }
+}
+
+
+void Grid::unblock(const glm::ivec2 &position)
+{
+    if (!contains(position) || !m_blocked_tiles.test(index(position)))
+    {
+        return;
+    }
+
+    m_blocked_tiles.reset(index(position));
+    m_version++;
+
+    for (GridListener *listener : m_listeners)
+    {
+        listener->tileChanged(position);
+    }
+}
+
+
+void Grid::clear()
+{
+    m_blocked_tiles.clear();
+    m_costs.clear();
+    m_cost_counts = {};
+    m_version++;
+
+    for (GridListener *listener : m_listeners)
+    {
+        listener->gridChanged();
+    }
+}
+
+
+std::uint64_t Grid::version() const
+{
+    return m_version;
+}
+
+
+void Grid::listen(GridListener *listener)
+{
+    m_listeners.push_back(listener);
+}
+
+
+void Grid::unlisten(GridListener *listener)
+{
+    std::erase(m_listeners, listener);
+}
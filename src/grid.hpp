@@ -0,0 +1,68 @@
+#pragma once
+
+
+#include "bit_set.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+class GridListener
+{
+public:
+    virtual ~GridListener() = default;
+
+    virtual void tileChanged(const glm::ivec2 &position) = 0;
+    virtual void gridChanged() = 0;
+};
+
+
+class Grid
+{
+public:
+    Grid(int width, int height);
+
+    [[nodiscard]] bool blocked(unsigned int index) const;
+    [[nodiscard]] bool blocked(const glm::ivec2 &position) const;
+    [[nodiscard]] bool contains(const glm::ivec2 &position) const;
+    [[nodiscard]] unsigned int index(const glm::ivec2 &position) const;
+    [[nodiscard]] glm::ivec2 position(unsigned int index) const;
+    [[nodiscard]] int width() const;
+    [[nodiscard]] int height() const;
+    [[nodiscard]] unsigned int tileCount() const;
+
+    // Cost of entering a tile, 1 unless a terrain cost was set.
+    [[nodiscard]] unsigned int cost(unsigned int index) const;
+    [[nodiscard]] unsigned int cost(const glm::ivec2 &position) const;
+    void cost(const glm::ivec2 &position, std::uint8_t cost);
+    [[nodiscard]] unsigned int minimumCost() const;
+    [[nodiscard]] bool uniformCost() const;
+
+    void block(const glm::ivec2 &position);
+    void unblock(const glm::ivec2 &position);
+    void clear();
+
+    // Bumped by every edit, so cached answers can tell whether they still hold.
+    [[nodiscard]] std::uint64_t version() const;
+
+    void listen(GridListener *listener);
+    void unlisten(GridListener *listener);
+
+
+private:
+    int m_width;
+    int m_height;
+
+    BitSet m_blocked_tiles;
+
+    // Allocated on the first terrain cost, maps without terrain only carry the bitset.
+    std::vector<std::uint8_t> m_costs;
+    std::array<unsigned int, 256> m_cost_counts = {};
+
+    std::uint64_t m_version = 0;
+
+    std::vector<GridListener *> m_listeners;
+};
@@ -0,0 +1,645 @@
+#include "hierarchy.hpp"
+
+#include <algorithm>
+
+
+static constexpr std::array DIRECTIONS = {
+        glm::ivec2(0, 1),
+        glm::ivec2(1, 0),
+        glm::ivec2(0, -1),
+        glm::ivec2(-1, 0)
+};
+
+
+static constexpr int SIDE_EAST = 0;
+static constexpr int SIDE_SOUTH = 1;
+
+// Open stretches at least this long get an entrance at both ends instead of one in the middle.
+static constexpr int ENTRANCE_SPLIT = 6;
+
+
+[[nodiscard]] static unsigned int manhattan(const glm::ivec2 &current_position, const glm::ivec2 &goal_position)
+{
+    return std::abs(current_position.x - goal_position.x) + std::abs(current_position.y - goal_position.y);
+}
+
+
+Hierarchy::Hierarchy(Grid &grid, const int cluster_size):
+    m_grid(grid),
+    m_cluster_size(std::max(cluster_size, 2))
+{
+    m_grid.listen(this);
+    rebuild();
+}
+
+
+Hierarchy::~Hierarchy()
+{
+    m_grid.unlisten(this);
+}
+
+
+void Hierarchy::rebuild()
+{
+    m_cluster_count = {
+        (m_grid.width() + m_cluster_size - 1) / m_cluster_size,
+        (m_grid.height() + m_cluster_size - 1) / m_cluster_size
+    };
+
+    const auto cluster_count = static_cast<std::size_t>(m_cluster_count.x) * static_cast<std::size_t>(m_cluster_count.y);
+    m_clusters.assign(cluster_count, {});
+    m_borders.assign(cluster_count * 2, {});
+    m_offsets.assign(cluster_count, 0);
+
+    const auto local_size = static_cast<std::size_t>(m_cluster_size) * static_cast<std::size_t>(m_cluster_size);
+    m_local_costs.resize(local_size);
+    m_local_parents.assign(local_size, NONE);
+    m_local_heap.resize(local_size);
+
+    m_dirty_borders.resize(cluster_count * 2);
+    m_dirty_clusters.resize(cluster_count);
+    gridChanged();
+
+    update();
+}
+
+
+void Hierarchy::update()
+{
+    if (!m_dirty)
+    {
+        return;
+    }
+
+    for (std::size_t border = 0; border < m_borders.size(); border++)
+    {
+        if (!m_dirty_borders.test(border))
+        {
+            continue;
+        }
+
+        const auto cluster = static_cast<std::uint32_t>(border / 2);
+        const int side = static_cast<int>(border % 2);
+
+        rebuildBorder(cluster, side);
+
+        // Both clusters along the border gain or lose entrances.
+        const glm::ivec2 cluster_position = clusterOrigin(cluster) / m_cluster_size;
+
+        m_dirty_clusters.set(cluster);
+        if (side == SIDE_EAST && cluster_position.x + 1 < m_cluster_count.x)
+        {
+            m_dirty_clusters.set(cluster + 1);
+        }
+        else if (side == SIDE_SOUTH && cluster_position.y + 1 < m_cluster_count.y)
+        {
+            m_dirty_clusters.set(cluster + static_cast<std::uint32_t>(m_cluster_count.x));
+        }
+    }
+
+    for (std::uint32_t cluster = 0; cluster < m_clusters.size(); cluster++)
+    {
+        if (m_dirty_clusters.test(cluster))
+        {
+            rebuildCluster(cluster);
+        }
+    }
+
+    m_dirty_borders.clear();
+    m_dirty_clusters.clear();
+
+    std::uint32_t offset = 0;
+    for (std::size_t cluster = 0; cluster < m_clusters.size(); cluster++)
+    {
+        m_offsets[cluster] = offset;
+        offset += static_cast<std::uint32_t>(m_clusters[cluster].entrances.size());
+    }
+
+    if (offset != m_node_count || m_node_costs.size() == 0)
+    {
+        m_node_count = offset;
+        m_node_costs.resize(m_node_count + 2);
+        m_node_parents.assign(m_node_count + 2, NONE);
+        m_node_heap.resize(m_node_count + 2);
+    }
+
+    m_dirty = false;
+}
+
+
+bool Hierarchy::dirty() const
+{
+    return m_dirty;
+}
+
+
+int Hierarchy::clusterSize() const
+{
+    return m_cluster_size;
+}
+
+
+std::size_t Hierarchy::nodeCount() const
+{
+    return m_node_count;
+}
+
+
+PathResult Hierarchy::findPath(const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    PathResult result;
+
+    update();
+
+    if (!m_grid.contains(start) || !m_grid.contains(goal) || m_grid.blocked(start) || m_grid.blocked(goal))
+    {
+        return result;
+    }
+
+    if (start == goal)
+    {
+        result.path.push_back(start);
+        result.found = true;
+        return result;
+    }
+
+    m_minimum_cost = m_grid.minimumCost();
+
+    const std::uint32_t start_node = m_node_count;
+    const std::uint32_t goal_node = m_node_count + 1;
+    const std::uint32_t start_tile = m_grid.index(start);
+    const std::uint32_t goal_tile = m_grid.index(goal);
+    const std::uint32_t start_cluster = cluster(start);
+    const std::uint32_t goal_cluster = cluster(goal);
+
+    // Connect the goal first, the start's search is still needed for the direct hop below.
+    searchCluster(goal_cluster, goal, nullptr, true);
+    m_goal_costs.clear();
+    for (const Entrance &entrance : m_clusters[goal_cluster].entrances)
+    {
+        m_goal_costs.push_back(m_local_costs.cost(localIndex(goal_cluster, m_grid.position(entrance.tile))));
+    }
+
+    searchCluster(start_cluster, start, nullptr, false);
+    m_start_costs.clear();
+    for (const Entrance &entrance : m_clusters[start_cluster].entrances)
+    {
+        m_start_costs.push_back(m_local_costs.cost(localIndex(start_cluster, m_grid.position(entrance.tile))));
+    }
+    const unsigned int direct_cost = start_cluster == goal_cluster ? m_local_costs.cost(localIndex(start_cluster, goal)) : CostTable::UNREACHED;
+
+    m_node_costs.reset();
+    m_node_heap.clear();
+
+    const auto relax = [&](const std::uint32_t node, const std::uint32_t parent, const unsigned int cost_g, const unsigned int cost_edge)
+    {
+        if (cost_edge == CostTable::UNREACHED || cost_g + cost_edge >= m_node_costs.cost(node))
+        {
+            return;
+        }
+
+        const unsigned int cost_h = manhattan(m_grid.position(nodeTile(node, start_tile, goal_tile)), goal) * m_minimum_cost;
+
+        m_node_costs.cost(node, cost_g + cost_edge);
+        m_node_parents[node] = parent;
+        m_node_heap.push(node, packKey(cost_g + cost_edge + cost_h, cost_h));
+    };
+
+    relax(start_node, NONE, 0, 0);
+
+    while (!m_node_heap.empty())
+    {
+        const std::uint32_t current = m_node_heap.pop();
+        const unsigned int current_g = m_node_costs.cost(current);
+
+        result.expanded++;
+        ASTAR_COUNT(result.stats.expanded++);
+
+        m_node_costs.close(current);
+
+        if (current == goal_node)
+        {
+            result.found = true;
+            break;
+        }
+
+        if (current == start_node)
+        {
+            for (std::size_t i = 0; i < m_start_costs.size(); i++)
+            {
+                relax(m_offsets[start_cluster] + static_cast<std::uint32_t>(i), current, current_g, m_start_costs[i]);
+            }
+            relax(goal_node, current, current_g, direct_cost);
+
+            continue;
+        }
+
+        const auto cluster_index = static_cast<std::uint32_t>(std::ranges::upper_bound(m_offsets, current) - m_offsets.begin() - 1);
+        const Cluster &current_cluster = m_clusters[cluster_index];
+        const std::uint32_t offset = m_offsets[cluster_index];
+        const std::uint32_t entrance = current - offset;
+        const std::size_t entrance_count = current_cluster.entrances.size();
+
+        for (std::size_t i = 0; i < entrance_count; i++)
+        {
+            if (i != entrance)
+            {
+                relax(offset + static_cast<std::uint32_t>(i), current, current_g, current_cluster.distances[entrance * entrance_count + i]);
+            }
+        }
+
+        for (const std::uint32_t partner : current_cluster.entrances[entrance].partners)
+        {
+            if (partner != NONE)
+            {
+                relax(node(partner), current, current_g, m_grid.cost(partner));
+            }
+        }
+
+        if (cluster_index == goal_cluster)
+        {
+            relax(goal_node, current, current_g, m_goal_costs[entrance]);
+        }
+    }
+
+    if (!result.found)
+    {
+        return result;
+    }
+
+    std::vector<std::uint32_t> waypoints;
+    for (std::uint32_t waypoint = goal_node; waypoint != NONE; waypoint = m_node_parents[waypoint])
+    {
+        waypoints.push_back(nodeTile(waypoint, start_tile, goal_tile));
+    }
+    std::ranges::reverse(waypoints);
+
+    result.cost = m_node_costs.cost(goal_node);
+    result.path.push_back(start);
+
+    for (std::size_t i = 1; i < waypoints.size(); i++)
+    {
+        const glm::ivec2 from = m_grid.position(waypoints[i - 1]);
+        const glm::ivec2 to = m_grid.position(waypoints[i]);
+
+        if (from == to)
+        {
+            continue;
+        }
+
+        if (cluster(from) != cluster(to))
+        {
+            result.path.push_back(to);
+        }
+        else
+        {
+            appendLocalPath(from, to, result.path);
+        }
+    }
+
+    return result;
+}
+
+
+void Hierarchy::tileChanged(const glm::ivec2 &position)
+{
+    const std::uint32_t tile_cluster = cluster(position);
+    const glm::ivec2 local = position - clusterOrigin(tile_cluster);
+    const auto columns = static_cast<std::uint32_t>(m_cluster_count.x);
+
+    m_dirty_clusters.set(tile_cluster);
+
+    if (local.x == m_cluster_size - 1)
+    {
+        m_dirty_borders.set(tile_cluster * 2 + SIDE_EAST);
+    }
+    else if (local.x == 0 && position.x > 0)
+    {
+        m_dirty_borders.set((tile_cluster - 1) * 2 + SIDE_EAST);
+    }
+
+    if (local.y == m_cluster_size - 1)
+    {
+        m_dirty_borders.set(tile_cluster * 2 + SIDE_SOUTH);
+    }
+    else if (local.y == 0 && position.y > 0)
+    {
+        m_dirty_borders.set((tile_cluster - columns) * 2 + SIDE_SOUTH);
+    }
+
+    m_dirty = true;
+}
+
+
+void Hierarchy::gridChanged()
+{
+    for (std::size_t border = 0; border < m_borders.size(); border++)
+    {
+        m_dirty_borders.set(border);
+    }
+
+    for (std::size_t cluster = 0; cluster < m_clusters.size(); cluster++)
+    {
+        m_dirty_clusters.set(cluster);
+    }
+
+    m_dirty = true;
+}
+
+
+std::uint32_t Hierarchy::cluster(const glm::ivec2 &position) const
+{
+    const glm::ivec2 cluster_position = position / m_cluster_size;
+
+    return static_cast<std::uint32_t>(cluster_position.x + cluster_position.y * m_cluster_count.x);
+}
+
+
+glm::ivec2 Hierarchy::clusterOrigin(const std::uint32_t cluster) const
+{
+    const auto columns = static_cast<std::uint32_t>(m_cluster_count.x);
+
+    return glm::ivec2(cluster % columns, cluster / columns) * m_cluster_size;
+}
+
+
+glm::ivec2 Hierarchy::clusterExtent(const std::uint32_t cluster) const
+{
+    const glm::ivec2 origin = clusterOrigin(cluster);
+
+    return glm::min(glm::ivec2(m_cluster_size), glm::ivec2(m_grid.width(), m_grid.height()) - origin);
+}
+
+
+std::uint32_t Hierarchy::localIndex(const std::uint32_t cluster, const glm::ivec2 &position) const
+{
+    const glm::ivec2 local = position - clusterOrigin(cluster);
+
+    return static_cast<std::uint32_t>(local.x + local.y * m_cluster_size);
+}
+
+
+std::uint32_t Hierarchy::node(const std::uint32_t tile) const
+{
+    const std::uint32_t tile_cluster = cluster(m_grid.position(tile));
+    const std::vector<Entrance> &entrances = m_clusters[tile_cluster].entrances;
+
+    const auto entrance = std::ranges::lower_bound(entrances, tile, {}, &Entrance::tile);
+
+    return m_offsets[tile_cluster] + static_cast<std::uint32_t>(entrance - entrances.begin());
+}
+
+
+std::uint32_t Hierarchy::nodeTile(const std::uint32_t node, const std::uint32_t start_tile, const std::uint32_t goal_tile) const
+{
+    if (node == m_node_count)
+    {
+        return start_tile;
+    }
+    if (node == m_node_count + 1)
+    {
+        return goal_tile;
+    }
+
+    const auto cluster_index = static_cast<std::size_t>(std::ranges::upper_bound(m_offsets, node) - m_offsets.begin() - 1);
+
+    return m_clusters[cluster_index].entrances[node - m_offsets[cluster_index]].tile;
+}
+
+
+void Hierarchy::rebuildBorder(const std::uint32_t cluster, const int side)
+{
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> &transitions = m_borders[cluster * 2 + static_cast<std::uint32_t>(side)];
+    transitions.clear();
+
+    const glm::ivec2 origin = clusterOrigin(cluster);
+    const glm::ivec2 extent = clusterExtent(cluster);
+
+    // Walks along the border, inside is the last row or column of this cluster and outside the first of its neighbour.
+    const glm::ivec2 step = side == SIDE_EAST ? glm::ivec2(0, 1) : glm::ivec2(1, 0);
+    const glm::ivec2 across = side == SIDE_EAST ? glm::ivec2(1, 0) : glm::ivec2(0, 1);
+    const glm::ivec2 inside = side == SIDE_EAST ? glm::ivec2(origin.x + extent.x - 1, origin.y) : glm::ivec2(origin.x, origin.y + extent.y - 1);
+    const int length = side == SIDE_EAST ? extent.y : extent.x;
+
+    if (!m_grid.contains(inside + across))
+    {
+        return;
+    }
+
+    const auto transition = [&](const int offset)
+    {
+        const glm::ivec2 position = inside + step * offset;
+        transitions.emplace_back(m_grid.index(position), m_grid.index(position + across));
+    };
+
+    int run_start = -1;
+    for (int i = 0; i <= length; i++)
+    {
+        const glm::ivec2 position = inside + step * i;
+        const bool open = i < length && !m_grid.blocked(position) && !m_grid.blocked(position + across);
+
+        if (open && run_start < 0)
+        {
+            run_start = i;
+        }
+        else if (!open && run_start >= 0)
+        {
+            const int run_end = i - 1;
+
+            if (run_end - run_start + 1 < ENTRANCE_SPLIT)
+            {
+                transition((run_start + run_end) / 2);
+            }
+            else
+            {
+                transition(run_start);
+                transition(run_end);
+            }
+
+            run_start = -1;
+        }
+    }
+}
+
+
+void Hierarchy::rebuildCluster(const std::uint32_t cluster)
+{
+    Cluster &data = m_clusters[cluster];
+    data.entrances.clear();
+
+    const glm::ivec2 cluster_position = clusterOrigin(cluster) / m_cluster_size;
+    const auto columns = static_cast<std::uint32_t>(m_cluster_count.x);
+
+    for (const int side : {SIDE_EAST, SIDE_SOUTH})
+    {
+        for (const auto &[inside, outside] : m_borders[cluster * 2 + static_cast<std::uint32_t>(side)])
+        {
+            data.entrances.push_back({inside, {outside, NONE}});
+        }
+    }
+
+    if (cluster_position.x > 0)
+    {
+        for (const auto &[inside, outside] : m_borders[(cluster - 1) * 2 + SIDE_EAST])
+        {
+            data.entrances.push_back({outside, {inside, NONE}});
+        }
+    }
+
+    if (cluster_position.y > 0)
+    {
+        for (const auto &[inside, outside] : m_borders[(cluster - columns) * 2 + SIDE_SOUTH])
+        {
+            data.entrances.push_back({outside, {inside, NONE}});
+        }
+    }
+
+    std::ranges::sort(data.entrances, {}, &Entrance::tile);
+
+    // A corner tile shows up once per border, keep one entrance with both partners.
+    std::size_t count = 0;
+    for (const Entrance &entrance : data.entrances)
+    {
+        if (count > 0 && data.entrances[count - 1].tile == entrance.tile)
+        {
+            data.entrances[count - 1].partners[1] = entrance.partners[0];
+            continue;
+        }
+
+        data.entrances[count++] = entrance;
+    }
+    data.entrances.resize(count);
+
+    data.distances.assign(count * count, CostTable::UNREACHED);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        searchCluster(cluster, m_grid.position(data.entrances[i].tile), nullptr, false);
+
+        for (std::size_t j = 0; j < count; j++)
+        {
+            data.distances[i * count + j] = m_local_costs.cost(localIndex(cluster, m_grid.position(data.entrances[j].tile)));
+        }
+    }
+}
+
+
+// Dijkstra from source over the tiles of one cluster, or A* if a target is given. The reverse search
+// pays for the tile it leaves, so its costs are the distances towards source rather than away from it.
+void Hierarchy::searchCluster(const std::uint32_t cluster, const glm::ivec2 &source, const glm::ivec2 *target, const bool reverse)
+{
+    const glm::ivec2 origin = clusterOrigin(cluster);
+    const glm::ivec2 extent = clusterExtent(cluster);
+    const auto stride = static_cast<std::uint32_t>(m_cluster_size);
+
+    m_local_costs.reset();
+    m_local_heap.clear();
+
+    const std::uint32_t source_index = localIndex(cluster, source);
+
+    // Without terrain every step costs the same, a breadth first flood is enough and much cheaper than the heap.
+    if (target == nullptr && m_grid.uniformCost())
+    {
+        const unsigned int step = m_grid.minimumCost();
+
+        m_local_queue.clear();
+        m_local_queue.push_back(source_index);
+        m_local_costs.cost(source_index, 0);
+
+        for (std::size_t head = 0; head < m_local_queue.size(); head++)
+        {
+            const std::uint32_t current_index = m_local_queue[head];
+            const unsigned int new_g = m_local_costs.cost(current_index) + step;
+            const glm::ivec2 current_position = origin + glm::ivec2(current_index % stride, current_index / stride);
+
+            for (const glm::ivec2 &offset : DIRECTIONS)
+            {
+                const glm::ivec2 local = current_position + offset - origin;
+
+                if (local.x < 0 || local.y < 0 || local.x >= extent.x || local.y >= extent.y || m_grid.blocked(current_position + offset))
+                {
+                    continue;
+                }
+
+                const auto neighbour_index = static_cast<std::uint32_t>(local.x) + static_cast<std::uint32_t>(local.y) * stride;
+                if (m_local_costs.cost(neighbour_index) == CostTable::UNREACHED)
+                {
+                    m_local_costs.cost(neighbour_index, new_g);
+                    m_local_queue.push_back(neighbour_index);
+                }
+            }
+        }
+
+        return;
+    }
+
+    const unsigned int source_h = target != nullptr ? manhattan(source, *target) * m_minimum_cost : 0;
+
+    m_local_costs.cost(source_index, 0);
+    m_local_parents[source_index] = NONE;
+    m_local_heap.push(source_index, packKey(source_h, source_h));
+
+    while (!m_local_heap.empty())
+    {
+        const std::uint32_t current_index = m_local_heap.pop();
+        const unsigned int current_g = m_local_costs.cost(current_index);
+        const glm::ivec2 current_position = origin + glm::ivec2(current_index % stride, current_index / stride);
+
+        m_local_costs.close(current_index);
+
+        if (target != nullptr && current_position == *target)
+        {
+            return;
+        }
+
+        const unsigned int leave_cost = reverse ? m_grid.cost(current_position) : 0;
+
+        for (const glm::ivec2 &offset : DIRECTIONS)
+        {
+            const glm::ivec2 neighbour_position = current_position + offset;
+            const glm::ivec2 local = neighbour_position - origin;
+
+            if (local.x < 0 || local.y < 0 || local.x >= extent.x || local.y >= extent.y)
+            {
+                continue;
+            }
+
+            const std::uint32_t grid_index = m_grid.index(neighbour_position);
+            if (m_grid.blocked(grid_index))
+            {
+                continue;
+            }
+
+            const auto neighbour_index = static_cast<std::uint32_t>(local.x) + static_cast<std::uint32_t>(local.y) * stride;
+            const unsigned int new_g = current_g + (reverse ? leave_cost : m_grid.cost(grid_index));
+            if (new_g >= m_local_costs.cost(neighbour_index))
+            {
+                continue;
+            }
+
+            const unsigned int cost_h = target != nullptr ? manhattan(neighbour_position, *target) * m_minimum_cost : 0;
+
+            m_local_costs.cost(neighbour_index, new_g);
+            m_local_parents[neighbour_index] = current_index;
+            m_local_heap.push(neighbour_index, packKey(new_g + cost_h, cost_h));
+        }
+    }
+}
+
+
+void Hierarchy::appendLocalPath(const glm::ivec2 &from, const glm::ivec2 &to, std::vector<glm::ivec2> &path)
+{
+    const std::uint32_t from_cluster = cluster(from);
+    const glm::ivec2 origin = clusterOrigin(from_cluster);
+    const auto stride = static_cast<std::uint32_t>(m_cluster_size);
+
+    searchCluster(from_cluster, from, &to, false);
+
+    const std::size_t first = path.size();
+    for (std::uint32_t index = localIndex(from_cluster, to); index != NONE && m_local_parents[index] != NONE; index = m_local_parents[index])
+    {
+        path.push_back(origin + glm::ivec2(index % stride, index / stride));
+    }
+
+    std::reverse(path.begin() + static_cast<std::ptrdiff_t>(first), path.end());
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+
+#include "bit_set.hpp"
+#include "cost_table.hpp"
+#include "grid.hpp"
+#include "indexed_heap.hpp"
+#include "search.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+// HPA* abstraction of a 4-connected grid. The grid is split into square clusters, entrances are placed
+// on every open stretch of a cluster border and connected by their exact distances inside the cluster.
+// Queries search the abstract graph and refine each hop with a search restricted to one cluster,
+// so paths are near optimal rather than optimal. Edits only dirty the clusters and borders they touch,
+// update() rebuilds those before the next query.
+class Hierarchy final : public GridListener
+{
+public:
+    static constexpr int DEFAULT_CLUSTER_SIZE = 16;
+
+
+    explicit Hierarchy(Grid &grid, int cluster_size = DEFAULT_CLUSTER_SIZE);
+    Hierarchy(const Hierarchy &) = delete;
+    ~Hierarchy() override;
+
+    void operator=(const Hierarchy &) = delete;
+
+    void rebuild();
+    void update();
+    [[nodiscard]] bool dirty() const;
+
+    [[nodiscard]] int clusterSize() const;
+    [[nodiscard]] std::size_t nodeCount() const;
+
+    [[nodiscard]] PathResult findPath(const glm::ivec2 &start, const glm::ivec2 &goal);
+
+    void tileChanged(const glm::ivec2 &position) override;
+    void gridChanged() override;
+
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+
+    struct Entrance
+    {
+        std::uint32_t tile;
+        // Tiles across the border, a corner tile can sit on two borders of its cluster.
+        std::array<std::uint32_t, 2> partners;
+    };
+
+
+    struct Cluster
+    {
+        std::vector<Entrance> entrances;
+        // Row i holds the costs from entrance i to every other entrance, UNREACHED if there is no way inside the cluster.
+        std::vector<unsigned int> distances;
+    };
+
+
+    Grid &m_grid;
+    int m_cluster_size;
+    glm::ivec2 m_cluster_count = {};
+
+    std::vector<Cluster> m_clusters;
+    // Transitions over the east and south border of every cluster as (inside, outside) tile pairs.
+    std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t>>> m_borders;
+
+    BitSet m_dirty_borders;
+    BitSet m_dirty_clusters;
+    bool m_dirty = true;
+
+    // First abstract node of every cluster, start and goal follow after the last entrance.
+    std::vector<std::uint32_t> m_offsets;
+    std::uint32_t m_node_count = 0;
+
+    CostTable m_node_costs;
+    std::vector<std::uint32_t> m_node_parents;
+    IndexedHeap<ASTAR_HEAP_ARITY> m_node_heap;
+
+    CostTable m_local_costs;
+    std::vector<std::uint32_t> m_local_parents;
+    IndexedHeap<ASTAR_HEAP_ARITY> m_local_heap;
+    std::vector<std::uint32_t> m_local_queue;
+
+    std::vector<unsigned int> m_start_costs;
+    std::vector<unsigned int> m_goal_costs;
+    unsigned int m_minimum_cost = 1;
+
+
+    [[nodiscard]] std::uint32_t cluster(const glm::ivec2 &position) const;
+    [[nodiscard]] glm::ivec2 clusterOrigin(std::uint32_t cluster) const;
+    [[nodiscard]] glm::ivec2 clusterExtent(std::uint32_t cluster) const;
+    [[nodiscard]] std::uint32_t localIndex(std::uint32_t cluster, const glm::ivec2 &position) const;
+    [[nodiscard]] std::uint32_t node(std::uint32_t tile) const;
+    [[nodiscard]] std::uint32_t nodeTile(std::uint32_t node, std::uint32_t start_tile, std::uint32_t goal_tile) const;
+
+    void rebuildBorder(std::uint32_t cluster, int side);
+    void rebuildCluster(std::uint32_t cluster);
+
+    void searchCluster(std::uint32_t cluster, const glm::ivec2 &source, const glm::ivec2 *target, bool reverse);
+    void appendLocalPath(const glm::ivec2 &from, const glm::ivec2 &to, std::vector<glm::ivec2> &path);
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+
+#include "open_list.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+
+template <unsigned int Arity>
+class IndexedHeap
+{
+public:
+    static_assert(Arity >= 2, "IndexedHeap needs at least two children per node");
+
+
+    void resize(const std::size_t tile_count)
+    {
+        m_nodes.clear();
+        m_positions.assign(tile_count, 0);
+    }
+
+    void clear()
+    {
+        m_nodes.clear();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_nodes.empty();
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_nodes.size();
+    }
+
+    [[nodiscard]] bool contains(const std::uint32_t index) const
+    {
+        const std::uint32_t position = m_positions[index];
+
+        return position < m_nodes.size() && m_nodes[position].index == index;
+    }
+
+    // Inserts the tile or moves it to its new key if it is already queued.
+    void push(const std::uint32_t index, const std::uint64_t key)
+    {
+        if (contains(index))
+        {
+            const std::uint32_t position = m_positions[index];
+            const std::uint64_t old_key = m_nodes[position].key;
+
+            m_nodes[position].key = key;
+            ASTAR_COUNT(m_stats.decreases++);
+
+            if (key < old_key)
+            {
+                siftUp(position);
+            }
+            else
+            {
+                siftDown(position);
+            }
+            return;
+        }
+
+        m_nodes.push_back({key, index});
+        ASTAR_COUNT(m_stats.pushes++);
+        ASTAR_COUNT(m_stats.peak_size = std::max<std::uint64_t>(m_stats.peak_size, m_nodes.size()));
+
+        siftUp(static_cast<std::uint32_t>(m_nodes.size() - 1));
+    }
+
+    [[nodiscard]] std::uint32_t top() const
+    {
+        return m_nodes.front().index;
+    }
+
+    [[nodiscard]] std::uint64_t topKey() const
+    {
+        return m_nodes.front().key;
+    }
+
+    std::uint32_t pop()
+    {
+        const std::uint32_t index = m_nodes.front().index;
+        ASTAR_COUNT(m_stats.pops++);
+
+        m_nodes.front() = m_nodes.back();
+        m_nodes.pop_back();
+
+        if (!m_nodes.empty())
+        {
+            siftDown(0);
+        }
+
+        return index;
+    }
+
+    void remove(const std::uint32_t index)
+    {
+        if (!contains(index))
+        {
+            return;
+        }
+
+        const std::uint32_t position = m_positions[index];
+        const std::uint64_t old_key = m_nodes[position].key;
+
+        m_nodes[position] = m_nodes.back();
+        m_nodes.pop_back();
+
+        if (position == m_nodes.size())
+        {
+            return;
+        }
+
+        if (m_nodes[position].key < old_key)
+        {
+            siftUp(position);
+        }
+        else
+        {
+            siftDown(position);
+        }
+    }
+
+    [[nodiscard]] const OpenListStats &stats() const
+    {
+        return m_stats;
+    }
+
+    void resetStats()
+    {
+        m_stats = {};
+    }
+
+
+private:
+    struct Node
+    {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+
+    std::vector<Node> m_nodes;
+    std::vector<std::uint32_t> m_positions;
+
+    OpenListStats m_stats;
+
+
+    void siftUp(std::uint32_t position)
+    {
+        const Node node = m_nodes[position];
+
+        while (position > 0)
+        {
+            const std::uint32_t parent = (position - 1) / Arity;
+            if (m_nodes[parent].key <= node.key)
+            {
+                break;
+            }
+
+            m_nodes[position] = m_nodes[parent];
+            m_positions[m_nodes[position].index] = position;
+            position = parent;
+        }
+
+        m_nodes[position] = node;
+        m_positions[node.index] = position;
+    }
+
+    void siftDown(std::uint32_t position)
+    {
+        const Node node = m_nodes[position];
+        const auto size = static_cast<std::uint32_t>(m_nodes.size());
+
+        while (true)
+        {
+            const std::uint32_t first_child = position * Arity + 1;
+            if (first_child >= size)
+            {
+                break;
+            }
+
+            const std::uint32_t last_child = first_child + Arity < size ? first_child + Arity : size;
+            std::uint32_t best_child = first_child;
+            for (std::uint32_t child = first_child + 1; child < last_child; child++)
+            {
+                if (m_nodes[child].key < m_nodes[best_child].key)
+                {
+                    best_child = child;
+                }
+            }
+
+            if (m_nodes[best_child].key >= node.key)
+            {
+                break;
+            }
+
+            m_nodes[position] = m_nodes[best_child];
+            m_positions[m_nodes[position].index] = position;
+            position = best_child;
+        }
+
+        m_nodes[position] = node;
+        m_positions[node.index] = position;
+    }
+};
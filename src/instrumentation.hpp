@@ -0,0 +1,20 @@
+#pragma once
+
+
+// Hot path counters and timers are only compiled in with ASTAR_INSTRUMENTATION,
+// production builds see an empty statement.
+#ifdef ASTAR_INSTRUMENTATION
+#define ASTAR_COUNT(expression) expression
+#else
+#define ASTAR_COUNT(expression) static_cast<void>(0)
+#endif
+
+
+[[nodiscard]] constexpr bool instrumented()
+{
+#ifdef ASTAR_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
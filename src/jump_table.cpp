@@ -0,0 +1,220 @@
+#include "jump_table.hpp"
+
+
+static constexpr int DISTANCE_MAX = INT16_MAX;
+
+
+JumpTable::JumpTable(Grid &grid):
+    m_grid(grid)
+{
+    m_grid.listen(this);
+    rebuild();
+}
+
+
+JumpTable::~JumpTable()
+{
+    m_grid.unlisten(this);
+}
+
+
+void JumpTable::rebuild()
+{
+    m_east.assign(m_grid.tileCount(), 0);
+    m_west.assign(m_grid.tileCount(), 0);
+    m_dirty_rows.resize(static_cast<std::size_t>(m_grid.height()));
+    m_dirty_rows.clear();
+
+    for (int y = 0; y < m_grid.height(); y++)
+    {
+        rebuildRow(y);
+    }
+
+    m_dirty = false;
+}
+
+
+void JumpTable::update()
+{
+    if (!m_dirty)
+    {
+        return;
+    }
+
+    for (int y = 0; y < m_grid.height(); y++)
+    {
+        if (m_dirty_rows.test(static_cast<std::size_t>(y)))
+        {
+            rebuildRow(y);
+        }
+    }
+
+    m_dirty_rows.clear();
+    m_dirty = false;
+}
+
+
+bool JumpTable::dirty() const
+{
+    return m_dirty;
+}
+
+
+std::int16_t JumpTable::distance(const unsigned int index, const int direction) const
+{
+    return direction > 0 ? m_east[index] : m_west[index];
+}
+
+
+void JumpTable::tileChanged(const glm::ivec2 &position)
+{
+    // Forced neighbours depend on the rows above and below as well.
+    for (int y = position.y - 1; y <= position.y + 1; y++)
+    {
+        if (y >= 0 && y < m_grid.height())
+        {
+            m_dirty_rows.set(static_cast<std::size_t>(y));
+        }
+    }
+
+    m_dirty = true;
+}
+
+
+void JumpTable::gridChanged()
+{
+    for (int y = 0; y < m_grid.height(); y++)
+    {
+        m_dirty_rows.set(static_cast<std::size_t>(y));
+    }
+
+    m_dirty = true;
+}
+
+
+void JumpTable::rebuildRow(const int y)
+{
+    const auto step = [this, y](std::vector<std::int16_t> &table, const int x, const int direction, const int previous)
+    {
+        const glm::ivec2 next(x + direction, y);
+        int value = 0;
+
+        if (!walkable(m_grid, next))
+        {
+            value = 0;
+        }
+        else if (forcedVertical(m_grid, next, direction, 1) || forcedVertical(m_grid, next, direction, -1))
+        {
+            value = 1;
+        }
+        else if (previous == CONTINUE)
+        {
+            value = CONTINUE;
+        }
+        else if (previous > 0)
+        {
+            value = previous + 1;
+        }
+        else
+        {
+            value = previous - 1;
+        }
+
+        if (value > DISTANCE_MAX || value < -DISTANCE_MAX)
+        {
+            value = CONTINUE;
+        }
+
+        table[m_grid.index({x, y})] = static_cast<std::int16_t>(value);
+        return value;
+    };
+
+    int previous = 0;
+    for (int x = m_grid.width() - 1; x >= 0; x--)
+    {
+        previous = step(m_east, x, 1, previous);
+    }
+
+    previous = 0;
+    for (int x = 0; x < m_grid.width(); x++)
+    {
+        previous = step(m_west, x, -1, previous);
+    }
+}
+
+
+bool walkable(const Grid &grid, const glm::ivec2 &position)
+{
+    return grid.contains(position) && !grid.blocked(position);
+}
+
+
+bool forcedVertical(const Grid &grid, const glm::ivec2 &position, const int direction_x, const int direction_y)
+{
+    return !walkable(grid, {position.x - direction_x, position.y + direction_y}) &&
+        walkable(grid, {position.x, position.y + direction_y});
+}
+
+
+std::optional<glm::ivec2> jumpHorizontal(const Grid &grid, const JumpTable *table, glm::ivec2 position, const int direction, const glm::ivec2 &goal)
+{
+    if (table != nullptr)
+    {
+        while (true)
+        {
+            const int distance = table->distance(grid.index(position), direction);
+            const int reach = distance == JumpTable::CONTINUE ? DISTANCE_MAX : std::abs(distance);
+            const int goal_distance = (goal.x - position.x) * direction;
+
+            if (goal.y == position.y && goal_distance > 0 && goal_distance <= reach)
+            {
+                return goal;
+            }
+            if (distance == JumpTable::CONTINUE)
+            {
+                position.x += DISTANCE_MAX * direction;
+                continue;
+            }
+            if (distance > 0)
+            {
+                return glm::ivec2(position.x + distance * direction, position.y);
+            }
+
+            return std::nullopt;
+        }
+    }
+
+    while (true)
+    {
+        position.x += direction;
+
+        if (!walkable(grid, position))
+        {
+            return std::nullopt;
+        }
+        if (position == goal || forcedVertical(grid, position, direction, 1) || forcedVertical(grid, position, direction, -1))
+        {
+            return position;
+        }
+    }
+}
+
+
+std::optional<glm::ivec2> jumpVertical(const Grid &grid, const JumpTable *table, glm::ivec2 position, const int direction, const glm::ivec2 &goal)
+{
+    while (true)
+    {
+        position.y += direction;
+
+        if (!walkable(grid, position))
+        {
+            return std::nullopt;
+        }
+        if (position == goal ||
+            jumpHorizontal(grid, table, position, 1, goal) ||
+            jumpHorizontal(grid, table, position, -1, goal))
+        {
+            return position;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+
+#include "bit_set.hpp"
+#include "grid.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+// Precomputed horizontal jump distances for 4-connected Jump Point Search (JPS+).
+// Edits only dirty the affected rows, update() recomputes them before the next search.
+class JumpTable final : public GridListener
+{
+public:
+    explicit JumpTable(Grid &grid);
+    JumpTable(const JumpTable &) = delete;
+    ~JumpTable() override;
+
+    void operator=(const JumpTable &) = delete;
+
+    void rebuild();
+    void update();
+    [[nodiscard]] bool dirty() const;
+
+    [[nodiscard]] std::int16_t distance(unsigned int index, int direction) const;
+
+    void tileChanged(const glm::ivec2 &position) override;
+    void gridChanged() override;
+
+
+    static constexpr std::int16_t CONTINUE = INT16_MIN;
+
+
+private:
+    Grid &m_grid;
+
+    std::vector<std::int16_t> m_east;
+    std::vector<std::int16_t> m_west;
+
+    BitSet m_dirty_rows;
+    bool m_dirty = true;
+
+
+    void rebuildRow(int y);
+};
+
+
+[[nodiscard]] bool walkable(const Grid &grid, const glm::ivec2 &position);
+[[nodiscard]] bool forcedVertical(const Grid &grid, const glm::ivec2 &position, int direction_x, int direction_y);
+
+[[nodiscard]] std::optional<glm::ivec2> jumpHorizontal(const Grid &grid, const JumpTable *table, glm::ivec2 position, int direction, const glm::ivec2 &goal);
+[[nodiscard]] std::optional<glm::ivec2> jumpVertical(const Grid &grid, const JumpTable *table, glm::ivec2 position, int direction, const glm::ivec2 &goal);
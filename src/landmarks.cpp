@@ -0,0 +1,434 @@
+#include "landmarks.hpp"
+
+#include "cost_table.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+
+
+static constexpr std::array DIRECTIONS = {
+        glm::ivec2(0, 1),
+        glm::ivec2(1, 0),
+        glm::ivec2(0, -1),
+        glm::ivec2(-1, 0)
+};
+
+
+static constexpr std::array<char, 4> MAGIC = {'A', 'L', 'T', '1'};
+static constexpr int MAXIMUM_COUNT = 64;
+
+
+template <typename T>
+static void write(std::ofstream &file, const T *values, const std::size_t count)
+{
+    file.write(reinterpret_cast<const char *>(values), static_cast<std::streamsize>(sizeof(T) * count));
+}
+
+
+template <typename T>
+static void read(std::ifstream &file, T *values, const std::size_t count)
+{
+    file.read(reinterpret_cast<char *>(values), static_cast<std::streamsize>(sizeof(T) * count));
+}
+
+
+Landmarks::Landmarks(Grid &grid):
+    m_grid(grid)
+{
+    m_grid.listen(this);
+}
+
+
+Landmarks::~Landmarks()
+{
+    m_grid.unlisten(this);
+}
+
+
+void Landmarks::build(const int count)
+{
+    if (count < 1 || count > MAXIMUM_COUNT)
+    {
+        std::cerr << "Landmark count has to be between 1 and " << MAXIMUM_COUNT << "\n";
+        return;
+    }
+
+    const std::uint32_t tile_count = m_grid.tileCount();
+
+    snapshot();
+    m_landmarks.clear();
+    m_scales.clear();
+    m_distances.assign(static_cast<std::size_t>(tile_count) * static_cast<std::size_t>(count), UNREACHED);
+
+    // Seed the sampling from the open tile closest to the centre, its farthest tile becomes the first landmark.
+    std::uint32_t seed = tile_count;
+    int seed_distance = INT32_MAX;
+    const glm::ivec2 centre(m_grid.width() / 2, m_grid.height() / 2);
+
+    for (std::uint32_t index = 0; index < tile_count; index++)
+    {
+        const glm::ivec2 delta = glm::abs(m_grid.position(index) - centre);
+        if (!m_grid.blocked(index) && delta.x + delta.y < seed_distance)
+        {
+            seed = index;
+            seed_distance = delta.x + delta.y;
+        }
+    }
+
+    m_ready = true;
+    m_stale = false;
+
+    if (seed == tile_count)
+    {
+        return;
+    }
+
+    flood(seed);
+
+    // Distance of every tile to the closest landmark so far, tiles outside the sampled component stay UNREACHED.
+    std::vector<unsigned int> closest = m_flood;
+    std::uint32_t next = seed;
+
+    for (std::uint32_t index = 0; index < tile_count; index++)
+    {
+        if (closest[index] != CostTable::UNREACHED && closest[index] > closest[next])
+        {
+            next = index;
+        }
+    }
+
+    while (static_cast<int>(m_landmarks.size()) < count)
+    {
+        const std::size_t landmark = m_landmarks.size();
+        m_landmarks.push_back(next);
+
+        flood(next);
+
+        unsigned int farthest = 0;
+        for (const unsigned int distance : m_flood)
+        {
+            if (distance != CostTable::UNREACHED)
+            {
+                farthest = std::max(farthest, distance);
+            }
+        }
+
+        // Rounding down keeps every stored distance a lower bound of the real one.
+        const unsigned int scale = farthest / (UNREACHED - 1) + 1;
+        m_scales.push_back(scale);
+
+        for (std::uint32_t index = 0; index < tile_count; index++)
+        {
+            if (m_flood[index] != CostTable::UNREACHED)
+            {
+                m_distances[index * static_cast<std::size_t>(count) + landmark] = static_cast<std::uint16_t>(m_flood[index] / scale);
+                closest[index] = std::min(closest[index], m_flood[index]);
+            }
+        }
+
+        for (std::uint32_t index = 0; index < tile_count; index++)
+        {
+            if (closest[index] != CostTable::UNREACHED && closest[index] > closest[next])
+            {
+                next = index;
+            }
+        }
+
+        // Every reachable tile is a landmark already.
+        if (closest[next] == 0)
+        {
+            break;
+        }
+    }
+
+    if (static_cast<int>(m_landmarks.size()) < count)
+    {
+        std::vector<std::uint16_t> distances(static_cast<std::size_t>(tile_count) * m_landmarks.size());
+        for (std::uint32_t index = 0; index < tile_count; index++)
+        {
+            std::copy_n(m_distances.begin() + static_cast<std::ptrdiff_t>(index * static_cast<std::size_t>(count)),
+                m_landmarks.size(), distances.begin() + static_cast<std::ptrdiff_t>(index * m_landmarks.size()));
+        }
+        m_distances = std::move(distances);
+    }
+}
+
+
+bool Landmarks::save(const std::string &path) const
+{
+    if (!m_ready)
+    {
+        std::cerr << "Landmarks have to be built before saving them to " << path << "\n";
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Could not open landmark file " << path << "\n";
+        return false;
+    }
+
+    const std::array<std::uint32_t, 3> header = {
+        static_cast<std::uint32_t>(m_grid.width()),
+        static_cast<std::uint32_t>(m_grid.height()),
+        static_cast<std::uint32_t>(m_landmarks.size())
+    };
+    const std::uint64_t map_fingerprint = fingerprint();
+
+    write(file, MAGIC.data(), MAGIC.size());
+    write(file, header.data(), header.size());
+    write(file, &map_fingerprint, 1);
+    write(file, m_landmarks.data(), m_landmarks.size());
+    write(file, m_scales.data(), m_scales.size());
+    write(file, m_distances.data(), m_distances.size());
+
+    if (!file)
+    {
+        std::cerr << "Could not write landmark file " << path << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+bool Landmarks::load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Could not open landmark file " << path << "\n";
+        return false;
+    }
+
+    std::array<char, 4> magic = {};
+    std::array<std::uint32_t, 3> header = {};
+    std::uint64_t map_fingerprint = 0;
+
+    read(file, magic.data(), magic.size());
+    read(file, header.data(), header.size());
+    read(file, &map_fingerprint, 1);
+
+    if (!file || magic != MAGIC || header[2] < 1 || header[2] > MAXIMUM_COUNT)
+    {
+        std::cerr << "Landmark file " << path << " has no valid header\n";
+        return false;
+    }
+
+    if (header[0] != static_cast<std::uint32_t>(m_grid.width()) ||
+        header[1] != static_cast<std::uint32_t>(m_grid.height()) ||
+        map_fingerprint != fingerprint())
+    {
+        std::cerr << "Landmark file " << path << " was made for a different map\n";
+        return false;
+    }
+
+    std::vector<std::uint32_t> landmarks(header[2]);
+    std::vector<unsigned int> scales(header[2]);
+    std::vector<std::uint16_t> distances(static_cast<std::size_t>(m_grid.tileCount()) * header[2]);
+
+    read(file, landmarks.data(), landmarks.size());
+    read(file, scales.data(), scales.size());
+    read(file, distances.data(), distances.size());
+
+    if (!file || std::ranges::any_of(landmarks, [&](const std::uint32_t index) { return index >= m_grid.tileCount(); }) ||
+        std::ranges::find(scales, 0u) != scales.end())
+    {
+        std::cerr << "Landmark file " << path << " ends early or is corrupt\n";
+        return false;
+    }
+
+    m_landmarks = std::move(landmarks);
+    m_scales = std::move(scales);
+    m_distances = std::move(distances);
+
+    snapshot();
+    m_ready = true;
+    m_stale = false;
+
+    return true;
+}
+
+
+bool Landmarks::valid(const Grid &grid) const
+{
+    return m_ready && !m_stale && &grid == &m_grid && !m_landmarks.empty();
+}
+
+
+std::size_t Landmarks::count() const
+{
+    return m_landmarks.size();
+}
+
+
+glm::ivec2 Landmarks::landmark(const std::size_t landmark) const
+{
+    return m_grid.position(m_landmarks[landmark]);
+}
+
+
+// The largest triangle bound |d(L, from) - d(L, to)| over all landmarks. Entering costs make distances
+// directed, subtracting the cost difference of both ends keeps the bound valid in either direction.
+unsigned int Landmarks::heuristic(const std::uint32_t from, const std::uint32_t to) const
+{
+    const std::size_t count = m_landmarks.size();
+    const std::uint16_t *from_distances = m_distances.data() + from * count;
+    const std::uint16_t *to_distances = m_distances.data() + to * count;
+
+    unsigned int best = 0;
+
+    for (std::size_t landmark = 0; landmark < count; landmark++)
+    {
+        const unsigned int from_distance = from_distances[landmark];
+        const unsigned int to_distance = to_distances[landmark];
+
+        if (from_distance == UNREACHED || to_distance == UNREACHED || from_distance == to_distance)
+        {
+            continue;
+        }
+
+        // Both distances were rounded down by up to scale - 1.
+        const unsigned int scale = m_scales[landmark];
+        const unsigned int difference = from_distance > to_distance ? from_distance - to_distance : to_distance - from_distance;
+
+        best = std::max(best, difference * scale - (scale - 1));
+    }
+
+    const unsigned int from_cost = m_costs[from];
+    const unsigned int to_cost = m_costs[to];
+    const unsigned int correction = from_cost > to_cost ? from_cost - to_cost : to_cost - from_cost;
+
+    return best > correction ? best - correction : 0;
+}
+
+
+void Landmarks::tileChanged(const glm::ivec2 &position)
+{
+    if (!m_ready)
+    {
+        return;
+    }
+
+    const std::uint32_t index = m_grid.index(position);
+    const std::uint8_t cost = snapshotCost(index);
+
+    if (cost != 0 && (m_costs[index] == 0 || cost < m_costs[index]))
+    {
+        m_stale = true;
+    }
+}
+
+
+void Landmarks::gridChanged()
+{
+    m_stale = true;
+}
+
+
+std::uint8_t Landmarks::snapshotCost(const std::uint32_t index) const
+{
+    return m_grid.blocked(index) ? 0 : static_cast<std::uint8_t>(m_grid.cost(index));
+}
+
+
+// FNV-1a over the blocked tiles and terrain costs.
+std::uint64_t Landmarks::fingerprint() const
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (std::uint32_t index = 0; index < m_grid.tileCount(); index++)
+    {
+        hash ^= snapshotCost(index);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+
+void Landmarks::snapshot()
+{
+    m_costs.resize(m_grid.tileCount());
+
+    for (std::uint32_t index = 0; index < m_grid.tileCount(); index++)
+    {
+        m_costs[index] = snapshotCost(index);
+    }
+}
+
+
+void Landmarks::flood(const std::uint32_t source)
+{
+    m_flood.assign(m_grid.tileCount(), CostTable::UNREACHED);
+    m_flood[source] = 0;
+
+    // Without terrain every step costs the same, a breadth first flood is enough and much cheaper than the heap.
+    if (m_grid.uniformCost())
+    {
+        const unsigned int step = m_grid.minimumCost();
+
+        m_queue.clear();
+        m_queue.push_back(source);
+
+        for (std::size_t head = 0; head < m_queue.size(); head++)
+        {
+            const std::uint32_t current_index = m_queue[head];
+            const unsigned int new_g = m_flood[current_index] + step;
+            const glm::ivec2 current_position = m_grid.position(current_index);
+
+            for (const glm::ivec2 &offset : DIRECTIONS)
+            {
+                const glm::ivec2 neighbour_position = current_position + offset;
+                if (!m_grid.contains(neighbour_position))
+                {
+                    continue;
+                }
+
+                const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+                if (!m_grid.blocked(neighbour_index) && m_flood[neighbour_index] == CostTable::UNREACHED)
+                {
+                    m_flood[neighbour_index] = new_g;
+                    m_queue.push_back(neighbour_index);
+                }
+            }
+        }
+
+        return;
+    }
+
+    m_heap.resize(m_grid.tileCount());
+    m_heap.push(source, 0);
+
+    while (!m_heap.empty())
+    {
+        const std::uint32_t current_index = m_heap.pop();
+        const unsigned int current_g = m_flood[current_index];
+        const glm::ivec2 current_position = m_grid.position(current_index);
+
+        for (const glm::ivec2 &offset : DIRECTIONS)
+        {
+            const glm::ivec2 neighbour_position = current_position + offset;
+            if (!m_grid.contains(neighbour_position))
+            {
+                continue;
+            }
+
+            const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+            if (m_grid.blocked(neighbour_index))
+            {
+                continue;
+            }
+
+            const unsigned int new_g = current_g + m_grid.cost(neighbour_index);
+            if (new_g < m_flood[neighbour_index])
+            {
+                m_flood[neighbour_index] = new_g;
+                m_heap.push(neighbour_index, new_g);
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+
+#include "grid.hpp"
+#include "indexed_heap.hpp"
+#include "search.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// ALT (A*, landmarks, triangle inequality) lower bounds for a 4-connected grid. build() picks landmarks
+// by farthest point sampling and stores the distance from every landmark to every tile as uint16,
+// scaled down when the map is too large or too expensive to fit. Tables can be saved once and loaded
+// on startup, load() rejects files made for a different map.
+//
+// Blocking tiles or raising costs only lengthens paths, so the tables stay admissible. Any edit that
+// could shorten a path marks them stale until the next build().
+class Landmarks final : public GridListener
+{
+public:
+    static constexpr int DEFAULT_COUNT = 8;
+    static constexpr std::uint16_t UNREACHED = UINT16_MAX;
+
+
+    explicit Landmarks(Grid &grid);
+    Landmarks(const Landmarks &) = delete;
+    ~Landmarks() override;
+
+    void operator=(const Landmarks &) = delete;
+
+    void build(int count = DEFAULT_COUNT);
+    [[nodiscard]] bool save(const std::string &path) const;
+    [[nodiscard]] bool load(const std::string &path);
+
+    // Whether the tables describe this grid and no edit since made them overestimate.
+    [[nodiscard]] bool valid(const Grid &grid) const;
+
+    [[nodiscard]] std::size_t count() const;
+    [[nodiscard]] glm::ivec2 landmark(std::size_t landmark) const;
+    [[nodiscard]] unsigned int heuristic(std::uint32_t from, std::uint32_t to) const;
+
+    void tileChanged(const glm::ivec2 &position) override;
+    void gridChanged() override;
+
+
+private:
+    Grid &m_grid;
+
+    std::vector<std::uint32_t> m_landmarks;
+    // Tile major, the distances of one tile to all landmarks share a cache line.
+    std::vector<std::uint16_t> m_distances;
+    // Stored distances are the real ones divided by the landmark's scale.
+    std::vector<unsigned int> m_scales;
+
+    // Entering cost of every tile when the tables were made, 0 for blocked tiles.
+    std::vector<std::uint8_t> m_costs;
+    bool m_ready = false;
+    bool m_stale = false;
+
+    std::vector<unsigned int> m_flood;
+    std::vector<std::uint32_t> m_queue;
+    IndexedHeap<ASTAR_HEAP_ARITY> m_heap;
+
+
+    [[nodiscard]] std::uint8_t snapshotCost(std::uint32_t index) const;
+    [[nodiscard]] std::uint64_t fingerprint() const;
+
+    void snapshot();
+    void flood(std::uint32_t source);
+};
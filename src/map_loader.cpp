@@ -0,0 +1,106 @@
+#include "map_loader.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+[[nodiscard]] static bool passable(const char terrain)
+{
+    return terrain == '.' || terrain == 'G' || terrain == 'S';
+}
+
+
+std::optional<Grid> loadMovingAIMap(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Could not open map " << path << "\n";
+        return std::nullopt;
+    }
+
+    int width = 0;
+    int height = 0;
+    std::string token;
+
+    while (file >> token && token != "map")
+    {
+        if (token == "width")
+        {
+            file >> width;
+        }
+        else if (token == "height")
+        {
+            file >> height;
+        }
+        else if (token == "type")
+        {
+            file >> token;
+        }
+    }
+
+    if (token != "map" || width <= 0 || height <= 0)
+    {
+        std::cerr << "Map " << path << " has no valid header\n";
+        return std::nullopt;
+    }
+
+    Grid grid(width, height);
+    std::string row;
+
+    for (int y = 0; y < height; y++)
+    {
+        if (!(file >> row) || static_cast<int>(row.size()) < width)
+        {
+            std::cerr << "Map " << path << " ends early in row " << y << "\n";
+            return std::nullopt;
+        }
+
+        for (int x = 0; x < width; x++)
+        {
+            if (!passable(row[x]))
+            {
+                grid.block({x, y});
+            }
+        }
+    }
+
+    return grid;
+}
+
+
+std::optional<std::vector<Scenario>> loadMovingAIScenario(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Could not open scenario " << path << "\n";
+        return std::nullopt;
+    }
+
+    std::vector<Scenario> scenarios;
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.starts_with("version"))
+        {
+            continue;
+        }
+
+        std::istringstream stream(line);
+        Scenario scenario = {};
+
+        if (!(stream >> scenario.bucket >> scenario.map >> scenario.size.x >> scenario.size.y >>
+            scenario.start.x >> scenario.start.y >> scenario.goal.x >> scenario.goal.y >> scenario.optimal_length))
+        {
+            std::cerr << "Skipping malformed scenario line in " << path << ": " << line << "\n";
+            continue;
+        }
+
+        scenarios.push_back(scenario);
+    }
+
+    return scenarios;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+
+#include "grid.hpp"
+
+#include <glm/glm.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+
+// Entry of a Moving AI benchmark scenario (.scen) file.
+struct Scenario
+{
+    int bucket;
+    std::string map;
+    glm::ivec2 size;
+    glm::ivec2 start;
+    glm::ivec2 goal;
+    double optimal_length;
+};
+
+
+[[nodiscard]] std::optional<Grid> loadMovingAIMap(const std::string &path);
+[[nodiscard]] std::optional<std::vector<Scenario>> loadMovingAIScenario(const std::string &path);
@@ -0,0 +1,35 @@
+#pragma once
+
+
+#include "instrumentation.hpp"
+
+#include <cstdint>
+
+
+struct OpenListStats
+{
+    std::uint64_t pushes = 0;
+    std::uint64_t decreases = 0;
+    std::uint64_t pops = 0;
+    std::uint64_t stale_pops = 0;
+    std::uint64_t peak_size = 0;
+};
+
+
+// Orders by f first and prefers the smaller h on ties, like the old Tile comparison.
+[[nodiscard]] constexpr std::uint64_t packKey(const unsigned int cost_f, const unsigned int cost_h)
+{
+    return static_cast<std::uint64_t>(cost_f) << 32 | cost_h;
+}
+
+
+[[nodiscard]] constexpr unsigned int keyCostF(const std::uint64_t key)
+{
+    return static_cast<unsigned int>(key >> 32);
+}
+
+
+[[nodiscard]] constexpr unsigned int keyCostH(const std::uint64_t key)
+{
+    return static_cast<unsigned int>(key & 0xFFFFFFFFu);
+}
@@ -0,0 +1,200 @@
+#include "path_cache.hpp"
+
+#include "grid.hpp"
+
+#include <algorithm>
+
+
+[[nodiscard]] static std::uint64_t key(const std::uint32_t start, const std::uint32_t goal)
+{
+    return static_cast<std::uint64_t>(start) << 32 | goal;
+}
+
+
+PathCache::PathCache(const std::size_t capacity, const Connectivity connectivity):
+    m_capacity(std::max<std::size_t>(capacity, 1)),
+    m_connectivity(connectivity)
+{
+}
+
+
+std::size_t PathCache::capacity() const
+{
+    return m_capacity;
+}
+
+
+void PathCache::capacity(const std::size_t capacity)
+{
+    m_capacity = std::max<std::size_t>(capacity, 1);
+
+    while (m_entries.size() > m_capacity)
+    {
+        evict();
+    }
+}
+
+
+Connectivity PathCache::connectivity() const
+{
+    return m_connectivity;
+}
+
+
+void PathCache::connectivity(const Connectivity connectivity)
+{
+    if (connectivity != m_connectivity)
+    {
+        clear();
+    }
+
+    m_connectivity = connectivity;
+}
+
+
+std::optional<PathResult> PathCache::find(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    synchronize(grid);
+
+    if (!grid.contains(start) || !grid.contains(goal))
+    {
+        m_stats.misses++;
+        return std::nullopt;
+    }
+
+    const std::uint32_t start_index = grid.index(start);
+    const std::uint32_t goal_index = grid.index(goal);
+
+    PathResult result;
+    result.found = true;
+
+    if (const auto it = m_lookup.find(key(start_index, goal_index)); it != m_lookup.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        m_stats.hits++;
+
+        result.path = it->second->path;
+        result.cost = it->second->costs.back();
+        return result;
+    }
+
+    if (const auto it = m_by_goal.find(goal_index); it != m_by_goal.end())
+    {
+        for (const Iterator entry : it->second)
+        {
+            const auto position = std::ranges::find(entry->path, start);
+            if (position == entry->path.end())
+            {
+                continue;
+            }
+
+            const auto offset = static_cast<std::size_t>(position - entry->path.begin());
+
+            m_entries.splice(m_entries.begin(), m_entries, entry);
+            m_stats.suffix_hits++;
+
+            result.path.assign(position, entry->path.end());
+            result.cost = entry->costs.back() - entry->costs[offset];
+            return result;
+        }
+    }
+
+    m_stats.misses++;
+    return std::nullopt;
+}
+
+
+void PathCache::insert(const Grid &grid, const PathResult &result)
+{
+    synchronize(grid);
+
+    if (!result.found || result.path.empty())
+    {
+        return;
+    }
+
+    const std::uint32_t start_index = grid.index(result.path.front());
+    const std::uint32_t goal_index = grid.index(result.path.back());
+
+    if (const auto it = m_lookup.find(key(start_index, goal_index)); it != m_lookup.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return;
+    }
+
+    if (m_entries.size() >= m_capacity)
+    {
+        evict();
+    }
+
+    Entry entry = {start_index, goal_index, result.path, {}};
+    entry.costs.reserve(entry.path.size());
+    entry.costs.push_back(0);
+
+    const bool eight = m_connectivity == Connectivity::EIGHT;
+    for (std::size_t i = 1; i < entry.path.size(); i++)
+    {
+        const glm::ivec2 delta = entry.path[i] - entry.path[i - 1];
+        const unsigned int step = !eight ? 1 : delta.x != 0 && delta.y != 0 ? Search::COST_DIAGONAL : Search::COST_STRAIGHT;
+
+        entry.costs.push_back(entry.costs.back() + step * grid.cost(entry.path[i]));
+    }
+
+    m_entries.push_front(std::move(entry));
+    m_lookup.emplace(key(start_index, goal_index), m_entries.begin());
+    m_by_goal[goal_index].push_back(m_entries.begin());
+}
+
+
+void PathCache::clear()
+{
+    m_entries.clear();
+    m_lookup.clear();
+    m_by_goal.clear();
+}
+
+
+std::size_t PathCache::size() const
+{
+    return m_entries.size();
+}
+
+
+const PathCacheStats &PathCache::stats() const
+{
+    return m_stats;
+}
+
+
+void PathCache::synchronize(const Grid &grid)
+{
+    if (grid.version() == m_version)
+    {
+        return;
+    }
+
+    if (!m_entries.empty())
+    {
+        m_stats.invalidations++;
+        clear();
+    }
+
+    m_version = grid.version();
+}
+
+
+void PathCache::evict()
+{
+    const Iterator last = std::prev(m_entries.end());
+
+    std::vector<Iterator> &same_goal = m_by_goal[last->goal];
+    std::erase(same_goal, last);
+    if (same_goal.empty())
+    {
+        m_by_goal.erase(last->goal);
+    }
+
+    m_lookup.erase(key(last->start, last->goal));
+    m_entries.erase(last);
+    m_stats.evictions++;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+
+#include "search.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+
+class Grid;
+
+
+struct PathCacheStats
+{
+    std::uint64_t hits = 0;
+    // Answered with the tail of a cached path that runs through the requested start.
+    std::uint64_t suffix_hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    // Times the grid was edited while the cache held paths, each one drops them all.
+    std::uint64_t invalidations = 0;
+};
+
+
+// Bounded LRU cache of found paths keyed by start, goal and grid version. Every tail of a shortest
+// path is a shortest path itself, so a query whose start lies on a cached path to the same goal
+// is answered from that path too. The step costs have to match the searches that filled the cache,
+// changing the connectivity drops all entries.
+class PathCache
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+
+    explicit PathCache(std::size_t capacity = DEFAULT_CAPACITY, Connectivity connectivity = Connectivity::FOUR);
+    PathCache(const PathCache &) = delete;
+
+    void operator=(const PathCache &) = delete;
+
+    [[nodiscard]] std::size_t capacity() const;
+    void capacity(std::size_t capacity);
+    [[nodiscard]] Connectivity connectivity() const;
+    void connectivity(Connectivity connectivity);
+
+    [[nodiscard]] std::optional<PathResult> find(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal);
+    void insert(const Grid &grid, const PathResult &result);
+    void clear();
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] const PathCacheStats &stats() const;
+
+
+private:
+    struct Entry
+    {
+        std::uint32_t start;
+        std::uint32_t goal;
+        std::vector<glm::ivec2> path;
+        // Cost from the start to every tile of the path.
+        std::vector<unsigned int> costs;
+    };
+
+
+    using Iterator = std::list<Entry>::iterator;
+
+
+    std::size_t m_capacity;
+    Connectivity m_connectivity;
+    std::uint64_t m_version = 0;
+
+    // Most recently used first.
+    std::list<Entry> m_entries;
+    std::unordered_map<std::uint64_t, Iterator> m_lookup;
+    std::unordered_map<std::uint32_t, std::vector<Iterator>> m_by_goal;
+
+    PathCacheStats m_stats;
+
+
+    void synchronize(const Grid &grid);
+    void evict();
+};
@@ -0,0 +1,270 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+
+// The search phase only touches the CPU side of the tile buffer.
+static bool timedOnGpu(const ProfilePhase phase)
+{
+    return phase != ProfilePhase::SEARCH;
+}
+
+
+static ProfileFrame emptyFrame(const std::uint64_t index)
+{
+    ProfileFrame frame;
+    frame.index = index;
+    frame.gpu_ns.fill(-1);
+
+    return frame;
+}
+
+
+const char *profilePhaseName(const ProfilePhase phase)
+{
+    switch (phase)
+    {
+        case ProfilePhase::SEARCH:
+            return "search";
+
+        case ProfilePhase::UPLOAD:
+            return "upload";
+
+        case ProfilePhase::DRAW:
+            return "draw";
+
+        case ProfilePhase::UI:
+            return "ui";
+    }
+
+    return "unknown";
+}
+
+
+Profiler::Profiler():
+    m_frame_start(Clock::now()),
+    m_current(emptyFrame(0)),
+    m_history(HISTORY_SIZE)
+{
+    for (std::array<GLuint, PROFILE_PHASE_COUNT> &queries : m_queries)
+    {
+        glCreateQueries(GL_TIME_ELAPSED, static_cast<GLsizei>(queries.size()), queries.data());
+    }
+}
+
+
+Profiler::~Profiler()
+{
+    for (const std::array<GLuint, PROFILE_PHASE_COUNT> &queries : m_queries)
+    {
+        glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    }
+}
+
+
+void Profiler::begin(const ProfilePhase phase)
+{
+    const auto index = static_cast<std::size_t>(phase);
+
+    if (timedOnGpu(phase))
+    {
+        glBeginQuery(GL_TIME_ELAPSED, m_queries[m_query_set][index]);
+    }
+
+    m_phase_start[index] = Clock::now();
+}
+
+
+void Profiler::end(const ProfilePhase phase)
+{
+    const auto index = static_cast<std::size_t>(phase);
+
+    m_current.cpu_ns[index] += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_phase_start[index]).count();
+
+    if (timedOnGpu(phase))
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_pending[m_query_set][index] = true;
+    }
+}
+
+
+void Profiler::frame(const std::uint64_t expansions, const std::size_t uploaded_bytes)
+{
+    const Clock::time_point now = Clock::now();
+
+    m_current.frame_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_frame_start).count();
+    m_frame_start = now;
+
+    // The total starts over with every new search.
+    m_current.expansions = expansions >= m_last_expansions ? expansions - m_last_expansions : expansions;
+    m_last_expansions = expansions;
+    m_current.uploaded_bytes = uploaded_bytes;
+
+    m_history[m_history_next] = m_current;
+    m_history_next = (m_history_next + 1) % HISTORY_SIZE;
+    m_history_count = std::min(m_history_count + 1, HISTORY_SIZE);
+
+    m_current = emptyFrame(m_current.index + 1);
+
+    // The other set was issued a frame ago and gets reused by the next one, its results belong to
+    // the frame before the one just closed.
+    m_query_set = (m_query_set + 1) % QUERY_SETS;
+
+    if (m_history_count >= 2)
+    {
+        collect(m_query_set, m_history[(m_history_next + HISTORY_SIZE - 2) % HISTORY_SIZE]);
+    }
+}
+
+
+std::size_t Profiler::frameCount() const
+{
+    return m_history_count;
+}
+
+
+const ProfileFrame &Profiler::history(const std::size_t index) const
+{
+    return m_history[(m_history_next + HISTORY_SIZE - m_history_count + index) % HISTORY_SIZE];
+}
+
+
+ProfileSummary Profiler::summary() const
+{
+    ProfileSummary summary;
+
+    if (m_history_count == 0)
+    {
+        return summary;
+    }
+
+    std::int64_t frame_ns = 0;
+    std::int64_t max_frame_ns = 0;
+    std::array<std::int64_t, PROFILE_PHASE_COUNT> cpu_ns = {};
+    std::array<std::int64_t, PROFILE_PHASE_COUNT> gpu_ns = {};
+    std::array<std::size_t, PROFILE_PHASE_COUNT> gpu_frames = {};
+    std::uint64_t expansions = 0;
+    std::size_t uploaded_bytes = 0;
+
+    for (std::size_t index = 0; index < m_history_count; index++)
+    {
+        const ProfileFrame &frame = history(index);
+
+        frame_ns += frame.frame_ns;
+        max_frame_ns = std::max(max_frame_ns, frame.frame_ns);
+        expansions += frame.expansions;
+        uploaded_bytes += frame.uploaded_bytes;
+
+        for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+        {
+            cpu_ns[phase] += frame.cpu_ns[phase];
+
+            if (frame.gpu_ns[phase] >= 0)
+            {
+                gpu_ns[phase] += frame.gpu_ns[phase];
+                gpu_frames[phase]++;
+            }
+        }
+    }
+
+    const auto frames = static_cast<double>(m_history_count);
+
+    summary.frame_ms = static_cast<double>(frame_ns) / frames / 1e6;
+    summary.max_frame_ms = static_cast<double>(max_frame_ns) / 1e6;
+    summary.expansions_per_second = frame_ns > 0 ? static_cast<double>(expansions) / (static_cast<double>(frame_ns) / 1e9) : 0.0;
+    summary.uploaded_bytes = static_cast<double>(uploaded_bytes) / frames;
+
+    for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        summary.cpu_ms[phase] = static_cast<double>(cpu_ns[phase]) / frames / 1e6;
+        summary.gpu_ms[phase] = gpu_frames[phase] > 0 ? static_cast<double>(gpu_ns[phase]) / static_cast<double>(gpu_frames[phase]) / 1e6 : 0.0;
+    }
+
+    return summary;
+}
+
+
+// Unread GPU times are left empty.
+bool Profiler::dump(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "Could not open profile file " << path << "\n";
+        return false;
+    }
+
+    file << "frame,frame_ns";
+    for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        file << "," << profilePhaseName(static_cast<ProfilePhase>(phase)) << "_cpu_ns";
+    }
+    for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        if (timedOnGpu(static_cast<ProfilePhase>(phase)))
+        {
+            file << "," << profilePhaseName(static_cast<ProfilePhase>(phase)) << "_gpu_ns";
+        }
+    }
+    file << ",expansions,uploaded_bytes\n";
+
+    for (std::size_t index = 0; index < m_history_count; index++)
+    {
+        const ProfileFrame &frame = history(index);
+
+        file << frame.index << "," << frame.frame_ns;
+        for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+        {
+            file << "," << frame.cpu_ns[phase];
+        }
+        for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+        {
+            if (!timedOnGpu(static_cast<ProfilePhase>(phase)))
+            {
+                continue;
+            }
+
+            file << ",";
+            if (frame.gpu_ns[phase] >= 0)
+            {
+                file << frame.gpu_ns[phase];
+            }
+        }
+        file << "," << frame.expansions << "," << frame.uploaded_bytes << "\n";
+    }
+
+    if (!file)
+    {
+        std::cerr << "Could not write profile file " << path << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+void Profiler::collect(const std::size_t set, ProfileFrame &frame)
+{
+    for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        if (!m_pending[set][phase])
+        {
+            continue;
+        }
+        m_pending[set][phase] = false;
+
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(m_queries[set][phase], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        {
+            continue;
+        }
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(m_queries[set][phase], GL_QUERY_RESULT, &elapsed);
+        frame.gpu_ns[phase] = static_cast<std::int64_t>(elapsed);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+
+#include <glad/glad.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+enum class ProfilePhase
+{
+    SEARCH,
+    UPLOAD,
+    DRAW,
+    UI
+};
+
+
+constexpr std::size_t PROFILE_PHASE_COUNT = 4;
+
+
+[[nodiscard]] const char *profilePhaseName(ProfilePhase phase);
+
+
+// Timings of one frame. GPU times stay negative where no query ran or its result came too late.
+struct ProfileFrame
+{
+    std::uint64_t index = 0;
+    std::int64_t frame_ns = 0;
+    std::array<std::int64_t, PROFILE_PHASE_COUNT> cpu_ns = {};
+    std::array<std::int64_t, PROFILE_PHASE_COUNT> gpu_ns = {};
+    std::uint64_t expansions = 0;
+    std::size_t uploaded_bytes = 0;
+};
+
+
+// Averages over the kept history, GPU averages only count frames whose queries were read.
+struct ProfileSummary
+{
+    double frame_ms = 0.0;
+    double max_frame_ms = 0.0;
+    std::array<double, PROFILE_PHASE_COUNT> cpu_ms = {};
+    std::array<double, PROFILE_PHASE_COUNT> gpu_ms = {};
+    double expansions_per_second = 0.0;
+    double uploaded_bytes = 0.0;
+};
+
+
+// Times the phases of every frame on the CPU and, for those issuing GL commands, with
+// GL_TIME_ELAPSED queries. The queries alternate between two sets and a set is read back one
+// frame later, results not available by then are dropped instead of waited for.
+class Profiler
+{
+public:
+    Profiler();
+    Profiler(const Profiler &) = delete;
+    ~Profiler();
+
+    void operator=(const Profiler &) = delete;
+
+    void begin(ProfilePhase phase);
+    void end(ProfilePhase phase);
+    // Closes the current frame, expansions is the running total of the search.
+    void frame(std::uint64_t expansions, std::size_t uploaded_bytes);
+
+    [[nodiscard]] std::size_t frameCount() const;
+    // Oldest first.
+    [[nodiscard]] const ProfileFrame &history(std::size_t index) const;
+    [[nodiscard]] ProfileSummary summary() const;
+
+    bool dump(const std::string &path) const;
+
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t HISTORY_SIZE = 240;
+    static constexpr std::size_t QUERY_SETS = 2;
+
+
+    std::array<std::array<GLuint, PROFILE_PHASE_COUNT>, QUERY_SETS> m_queries = {};
+    std::array<std::array<bool, PROFILE_PHASE_COUNT>, QUERY_SETS> m_pending = {};
+    std::size_t m_query_set = 0;
+
+    std::array<Clock::time_point, PROFILE_PHASE_COUNT> m_phase_start = {};
+    Clock::time_point m_frame_start;
+
+    ProfileFrame m_current;
+    std::uint64_t m_last_expansions = 0;
+
+    std::vector<ProfileFrame> m_history;
+    std::size_t m_history_next = 0;
+    std::size_t m_history_count = 0;
+
+
+    void collect(std::size_t set, ProfileFrame &frame);
+};
@@ -1,12 +1,15 @@
 #include "project.hpp"
 
+#include "global.hpp"
+
 #include <cassert>
+#include <cstdlib>
 
 
-Project::Project():
+Project::Project(const glm::ivec2 &grid_size):
     m_window(this),
-    m_renderer(m_window),
-    m_astar(m_window, m_renderer.buffer(), {80, 20}, {20, 80})
+    m_renderer(m_window, grid_size),
+    m_astar(m_window, m_renderer.buffer(), grid_size, {grid_size.x * 4 / 5, grid_size.y / 5}, {grid_size.x / 5, grid_size.y * 4 / 5})
 {
     m_renderer.astar(&m_astar);
 }
@@ -20,10 +23,14 @@ void Project::run()
 
         m_renderer.processClick(m_window.cursorPosition());
 
+        Profiler *profiler = m_renderer.profiler();
+        profiler->begin(ProfilePhase::SEARCH);
         if (m_renderer.automatic())
         {
-            m_astar.step();
+            m_astar.step(m_renderer.stepBudget());
         }
+        m_astar.update();
+        profiler->end(ProfilePhase::SEARCH);
 
         m_renderer.render();
     }
@@ -55,6 +62,15 @@ void Project::keyCallback(GLFWwindow *handle, const int key, [[maybe_unused]] in
 }
 
 
+void Project::scrollCallback(GLFWwindow *handle, [[maybe_unused]] double xoffset, const double yoffset)
+{
+    auto *project = static_cast<Project *>(glfwGetWindowUserPointer(handle));
+    assert(project != nullptr);
+
+    project->m_renderer.zoom(static_cast<float>(yoffset), project->m_window.cursorPosition());
+}
+
+
 void Project::windowContentScaleCallback(GLFWwindow *handle, float xscale, float yscale)
 {
     const Project *project = static_cast<Project *>(glfwGetWindowUserPointer(handle));
@@ -73,9 +89,20 @@ void Project::windowRefreshCallback(GLFWwindow *handle)
 }
 
 
-int main()
+int main(const int argc, char **argv)
 {
-    Project project;
+    glm::ivec2 grid_size(GLOBAL::GRID_SIZE, GLOBAL::GRID_SIZE);
+
+    if (argc >= 3)
+    {
+        grid_size = {std::atoi(argv[1]), std::atoi(argv[2])};
+    }
+    if (grid_size.x <= 0 || grid_size.y <= 0)
+    {
+        grid_size = {GLOBAL::GRID_SIZE, GLOBAL::GRID_SIZE};
+    }
+
+    Project project(grid_size);
     project.run();
 
     return 0;
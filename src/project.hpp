@@ -9,7 +9,7 @@
 class Project
 {
 public:
-    Project();
+    explicit Project(const glm::ivec2 &grid_size);
 
     void run();
 
@@ -21,6 +21,7 @@ private:
 
     static void framebufferSizeCallback(GLFWwindow *handle, int width, int height);
     static void keyCallback(GLFWwindow *handle, int key, int scancode, int action, int mods);
+    static void scrollCallback(GLFWwindow *handle, double xoffset, double yoffset);
     static void windowContentScaleCallback(GLFWwindow *handle, float xscale, float yscale);
     static void windowRefreshCallback(GLFWwindow *handle);
 
@@ -8,9 +8,20 @@
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
+#include <cfloat>
+
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 
+static constexpr float ZOOM_STEP = 1.1f;
+static constexpr float MIN_ZOOM = 1.0f / 256.0f;
+static constexpr float MAX_ZOOM = 8.0f;
+
+static constexpr auto PROFILE_PATH = "profile.csv";
+
+
 void updateViewport(const glm::ivec2 &size)
 {
     glViewport(0, 0, size.x, size.y);
@@ -175,7 +186,7 @@ static void initUI(const Window &window)
 }
 
 
-Renderer::Renderer(const Window &window):
+Renderer::Renderer(const Window &window, const glm::ivec2 &grid_size):
     m_window(window)
 {
     m_window.context();
@@ -199,7 +210,8 @@ Renderer::Renderer(const Window &window):
     initOpenGLDebug();
     initUI(m_window);
 
-    m_buffer = std::make_unique<Buffer>(m_window);
+    m_buffer = std::make_unique<Buffer>(m_window, grid_size);
+    m_profiler = std::make_unique<Profiler>();
 }
 
 
@@ -223,20 +235,62 @@ bool Renderer::automatic() const
 }
 
 
+StepBudget Renderer::stepBudget() const
+{
+    StepBudget budget;
+    budget.steps = 0;
+
+    switch (static_cast<BudgetMode>(m_budget_mode))
+    {
+        case BudgetMode::NODES:
+            budget.steps = static_cast<std::uint64_t>(m_budget_nodes);
+            break;
+
+        case BudgetMode::TIME:
+            budget.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float, std::milli>(m_budget_milliseconds));
+            break;
+
+        case BudgetMode::COMPLETE:
+            break;
+    }
+
+    return budget;
+}
+
+
 Buffer *Renderer::buffer() const
 {
     return m_buffer.get();
 }
 
 
+Profiler *Renderer::profiler() const
+{
+    return m_profiler.get();
+}
+
+
 void Renderer::processClick(const glm::ivec2 &cursor_position)
 {
+    const glm::ivec2 cursor_delta = cursor_position - m_last_cursor;
+    m_last_cursor = cursor_position;
+
+    if (m_window.cursorHeld(GLFW_MOUSE_BUTTON_MIDDLE) && !ImGui::GetIO().WantCaptureMouse)
+    {
+        camera(m_camera_offset - glm::vec2(cursor_delta) / m_zoom, m_zoom);
+        return;
+    }
+
     if (m_astar == nullptr)
     {
         return;
     }
 
-    const glm::ivec2 tile_position = {cursor_position.y / GLOBAL::TILE_SIZE, cursor_position.x / GLOBAL::TILE_SIZE};
+    // Tiles are drawn transposed, the cursor's x picks the row.
+    const glm::vec2 world_position = m_camera_offset + glm::vec2(cursor_position) / m_zoom;
+    const glm::ivec2 tile_position = {
+        static_cast<int>(std::floor(world_position.y / static_cast<float>(GLOBAL::TILE_SIZE))),
+        static_cast<int>(std::floor(world_position.x / static_cast<float>(GLOBAL::TILE_SIZE)))};
 
     if (m_click_mode == ClickMode::START && m_window.cursorHeld(GLFW_MOUSE_BUTTON_LEFT))
     {
@@ -250,7 +304,11 @@ void Renderer::processClick(const glm::ivec2 &cursor_position)
     }
     else
     {
-        if (m_window.cursorHeld(GLFW_MOUSE_BUTTON_LEFT))
+        if (m_window.cursorHeld(GLFW_MOUSE_BUTTON_LEFT) && m_paint_terrain)
+        {
+            m_astar->terrain(tile_position, m_terrain_cost);
+        }
+        else if (m_window.cursorHeld(GLFW_MOUSE_BUTTON_LEFT))
         {
             m_astar->addBlocked(tile_position);
         }
@@ -262,6 +320,23 @@ void Renderer::processClick(const glm::ivec2 &cursor_position)
 }
 
 
+void Renderer::zoom(const float steps, const glm::ivec2 &cursor_position)
+{
+    if (ImGui::GetIO().WantCaptureMouse)
+    {
+        return;
+    }
+
+    const float zoom = std::clamp(m_zoom * std::pow(ZOOM_STEP, steps), MIN_ZOOM, MAX_ZOOM);
+
+    // Keeps the world point under the cursor in place.
+    const glm::vec2 cursor = cursor_position;
+    const glm::vec2 anchor = m_camera_offset + cursor / m_zoom;
+
+    camera(anchor - cursor / zoom, zoom);
+}
+
+
 void Renderer::updateWindowScale(const glm::ivec2 &size) const
 {
     m_buffer->updateScale(size);
@@ -272,15 +347,32 @@ void Renderer::render()
 {
     glClear(GL_COLOR_BUFFER_BIT);
 
+    m_profiler->begin(ProfilePhase::UPLOAD);
     m_buffer->update();
+    m_profiler->end(ProfilePhase::UPLOAD);
+
+    m_profiler->begin(ProfilePhase::DRAW);
     m_buffer->render();
+    m_profiler->end(ProfilePhase::DRAW);
 
+    m_profiler->begin(ProfilePhase::UI);
     renderUI();
+    m_profiler->end(ProfilePhase::UI);
+
+    m_profiler->frame(m_astar != nullptr ? m_astar->expansions() : 0, m_buffer->uploadedBytes());
 
     m_window.swap();
 }
 
 
+void Renderer::camera(const glm::vec2 &offset, const float zoom)
+{
+    m_camera_offset = offset;
+    m_zoom = zoom;
+    m_buffer->camera(m_camera_offset, m_zoom);
+}
+
+
 void Renderer::renderUI()
 {
     if (m_astar == nullptr)
@@ -301,6 +393,15 @@ void Renderer::renderUI()
     ImGui::Text("You can use the left and right\nmouse buttons to add and remove blockades\nand press Enter to run the Algorithim\nin its current mode.\nPress Escape to reset it.");
     ImGui::NewLine();
 
+    ImGui::Text("Drag with the middle mouse button to pan\nand scroll to zoom.");
+    ImGui::Text("Zoom: %.3fx", static_cast<double>(m_zoom));
+    ImGui::SameLine();
+    if (ImGui::Button("Reset View"))
+    {
+        camera({0.0f, 0.0f}, 1.0f);
+    }
+    ImGui::NewLine();
+
     ImGui::TextUnformatted("Fill Plane with Noise (%):");
     ImGui::InputInt("## Input", &m_noise_percent);
     if (ImGui::Button("Fill"))
@@ -308,6 +409,71 @@ void Renderer::renderUI()
         m_astar->noise(m_noise_percent);
     }
 
+    ImGui::NewLine();
+    ImGui::Text("Left Click paints:");
+    ImGui::RadioButton("Blockades", &m_paint_terrain, false);
+    ImGui::SameLine();
+    ImGui::RadioButton("Terrain", &m_paint_terrain, true);
+    ImGui::SliderInt("Terrain Cost", &m_terrain_cost, 1, 255);
+
+    ImGui::NewLine();
+    ImGui::Text("Search Mode:");
+    ImGui::BeginDisabled(m_astar->started());
+    bool mode_changed = ImGui::RadioButton("A*", &m_search_mode, static_cast<int>(SearchMode::ASTAR));
+    ImGui::SameLine();
+    mode_changed |= ImGui::RadioButton("JPS", &m_search_mode, static_cast<int>(SearchMode::JPS));
+    ImGui::SameLine();
+    mode_changed |= ImGui::RadioButton("JPS+", &m_search_mode, static_cast<int>(SearchMode::JPS_PLUS));
+    ImGui::SameLine();
+    mode_changed |= ImGui::RadioButton("Bidirectional", &m_search_mode, static_cast<int>(SearchMode::BIDIRECTIONAL));
+
+    bool connectivity_changed = ImGui::RadioButton("4-connected", &m_connectivity, static_cast<int>(Connectivity::FOUR));
+    ImGui::SameLine();
+    connectivity_changed |= ImGui::RadioButton("8-connected", &m_connectivity, static_cast<int>(Connectivity::EIGHT));
+
+    ImGui::BeginDisabled(m_connectivity != static_cast<int>(Connectivity::EIGHT));
+    ImGui::Text("Corners:");
+    bool corner_policy_changed = ImGui::RadioButton("Allow", &m_corner_policy, static_cast<int>(CornerPolicy::ALLOW));
+    ImGui::SameLine();
+    corner_policy_changed |= ImGui::RadioButton("No Squeeze", &m_corner_policy, static_cast<int>(CornerPolicy::NO_SQUEEZE));
+    ImGui::SameLine();
+    corner_policy_changed |= ImGui::RadioButton("No Cut", &m_corner_policy, static_cast<int>(CornerPolicy::NO_CUT));
+    ImGui::EndDisabled();
+
+    const bool hierarchical_changed = ImGui::Checkbox("Hierarchical (HPA*)", &m_hierarchical);
+    const bool incremental_changed = ImGui::Checkbox("Incremental (D* Lite)", &m_incremental);
+    ImGui::BeginDisabled(m_connectivity != static_cast<int>(Connectivity::FOUR));
+    bool flow_field_changed = ImGui::Checkbox("Flow field (4-connected)", &m_flow_field);
+    ImGui::EndDisabled();
+    ImGui::EndDisabled();
+
+    if (mode_changed)
+    {
+        m_astar->mode(static_cast<SearchMode>(m_search_mode));
+    }
+    if (connectivity_changed)
+    {
+        m_astar->connectivity(static_cast<Connectivity>(m_connectivity));
+        flow_field_changed |= m_flow_field != m_astar->flowField();
+        m_flow_field = m_astar->flowField();
+    }
+    if (corner_policy_changed)
+    {
+        m_astar->cornerPolicy(static_cast<CornerPolicy>(m_corner_policy));
+    }
+    if (hierarchical_changed)
+    {
+        m_astar->hierarchical(m_hierarchical);
+    }
+    if (incremental_changed)
+    {
+        m_astar->incremental(m_incremental);
+    }
+    if (flow_field_changed)
+    {
+        m_astar->flowField(m_flow_field);
+    }
+
     ImGui::NewLine();
     ImGui::Text("Set Start/Goal on next Click:");
     if (ImGui::Button("Start"))
@@ -330,6 +496,25 @@ void Renderer::renderUI()
     ImGui::SameLine();
     ImGui::RadioButton("Automatic", &m_automatic, true);
 
+    if (m_automatic == true)
+    {
+        ImGui::Text("Budget per Frame:");
+        ImGui::RadioButton("Nodes", &m_budget_mode, static_cast<int>(BudgetMode::NODES));
+        ImGui::SameLine();
+        ImGui::RadioButton("Time", &m_budget_mode, static_cast<int>(BudgetMode::TIME));
+        ImGui::SameLine();
+        ImGui::RadioButton("To Completion", &m_budget_mode, static_cast<int>(BudgetMode::COMPLETE));
+
+        if (m_budget_mode == static_cast<int>(BudgetMode::NODES))
+        {
+            ImGui::SliderInt("Nodes", &m_budget_nodes, 1, 100000, "%d", ImGuiSliderFlags_Logarithmic);
+        }
+        else if (m_budget_mode == static_cast<int>(BudgetMode::TIME))
+        {
+            ImGui::SliderFloat("Milliseconds", &m_budget_milliseconds, 0.1f, 16.0f, "%.1f");
+        }
+    }
+
     ImGui::NewLine();
     ImGui::Text("Controls:");
     if (!m_astar->started() && ImGui::Button("Run"))
@@ -365,8 +550,85 @@ void Renderer::renderUI()
         }
     }
 
+    const StepProgress progress = m_astar->lastStep();
+    if (m_astar->started() && progress.steps > 0)
+    {
+        ImGui::Text("Last step: %llu nodes in %.2f ms", static_cast<unsigned long long>(progress.steps), static_cast<double>(progress.elapsed.count()) / 1e6);
+    }
+
+    if (instrumented() && m_astar->started())
+    {
+        const SearchStats stats = m_astar->stats();
+
+        ImGui::NewLine();
+        ImGui::Separator();
+        ImGui::Text("Statistics");
+        ImGui::Text("Expanded: %llu", static_cast<unsigned long long>(stats.expanded));
+        ImGui::Text("Generated: %llu", static_cast<unsigned long long>(stats.generated));
+        ImGui::Text("Reopened: %llu", static_cast<unsigned long long>(stats.reopened));
+        ImGui::Text("Peak open list: %llu", static_cast<unsigned long long>(stats.peak_open));
+    }
+
+    if (m_astar->started())
+    {
+        const PathCacheStats &cache_stats = m_astar->cacheStats();
+
+        ImGui::NewLine();
+        ImGui::Separator();
+        ImGui::Text("Path Cache");
+        ImGui::Text("Hits: %llu (%llu suffix)", static_cast<unsigned long long>(cache_stats.hits + cache_stats.suffix_hits), static_cast<unsigned long long>(cache_stats.suffix_hits));
+        ImGui::Text("Misses: %llu", static_cast<unsigned long long>(cache_stats.misses));
+        ImGui::Text("Invalidations: %llu", static_cast<unsigned long long>(cache_stats.invalidations));
+    }
+
     ImGui::End();
 
+    renderProfiler();
+
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
+
+
+void Renderer::renderProfiler()
+{
+    const ProfileSummary summary = m_profiler->summary();
+
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x, 0), ImGuiCond_Always, ImVec2(1, 0));
+    ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+
+    ImGui::Text("Frame: %.2f ms (max %.2f ms)", summary.frame_ms, summary.max_frame_ms);
+
+    const auto frame_milliseconds = [](void *data, const int index)
+    {
+        const ProfileFrame &frame = static_cast<const Profiler *>(data)->history(static_cast<std::size_t>(index));
+        return static_cast<float>(frame.frame_ns) / 1e6f;
+    };
+    ImGui::PlotLines("## Frame Times", frame_milliseconds, m_profiler.get(), static_cast<int>(m_profiler->frameCount()), 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+
+    ImGui::NewLine();
+    for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        const char *name = profilePhaseName(static_cast<ProfilePhase>(phase));
+
+        if (static_cast<ProfilePhase>(phase) == ProfilePhase::SEARCH)
+        {
+            ImGui::Text("%-7s CPU %6.2f ms", name, summary.cpu_ms[phase]);
+        }
+        else
+        {
+            ImGui::Text("%-7s CPU %6.2f ms  GPU %6.2f ms", name, summary.cpu_ms[phase], summary.gpu_ms[phase]);
+        }
+    }
+
+    ImGui::NewLine();
+    ImGui::Text("Expansions: %.0f /s", summary.expansions_per_second);
+    ImGui::Text("Uploaded: %.0f bytes/frame", summary.uploaded_bytes);
+
+    if (ImGui::Button("Dump CSV") && m_profiler->dump(PROFILE_PATH))
+    {
+        std::cout << "Wrote the last " << m_profiler->frameCount() << " frames to " << PROFILE_PATH << "\n";
+    }
+
+    ImGui::End();
+}
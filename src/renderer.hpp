@@ -2,6 +2,8 @@
 
 
 #include "buffer.hpp"
+#include "profiler.hpp"
+#include "search.hpp"
 
 #include <glm/glm.hpp>
 
@@ -15,6 +17,14 @@ class Window;
 void updateViewport(const glm::ivec2 &size);
 
 
+enum class BudgetMode
+{
+    NODES,
+    TIME,
+    COMPLETE
+};
+
+
 enum class ClickMode
 {
     DEFAULT,
@@ -26,7 +36,7 @@ enum class ClickMode
 class Renderer
 {
 public:
-    explicit Renderer(const Window &window);
+    Renderer(const Window &window, const glm::ivec2 &grid_size);
     Renderer(const Renderer &) = delete;
     ~Renderer();
 
@@ -34,9 +44,13 @@ public:
 
     void astar(AStar *astar);
     [[nodiscard]] bool automatic() const;
+    [[nodiscard]] StepBudget stepBudget() const;
     [[nodiscard]] Buffer *buffer() const;
+    [[nodiscard]] Profiler *profiler() const;
 
     void processClick(const glm::ivec2 &cursor_position);
+    // Zooms about the cursor, one step per notch of the mouse wheel.
+    void zoom(float steps, const glm::ivec2 &cursor_position);
     void updateWindowScale(const glm::ivec2 &size) const;
 
     void render();
@@ -47,11 +61,30 @@ private:
     AStar *m_astar = nullptr;
 
     std::unique_ptr<Buffer> m_buffer;
+    std::unique_ptr<Profiler> m_profiler;
+
+    // World pixels scrolled past the top left corner, and screen pixels per world pixel.
+    glm::vec2 m_camera_offset = {0.0f, 0.0f};
+    float m_zoom = 1.0f;
+    glm::ivec2 m_last_cursor = {0, 0};
 
     ClickMode m_click_mode = ClickMode::DEFAULT;
     int m_noise_percent = 0;
+    int m_search_mode = 0;
+    int m_connectivity = 0;
+    int m_corner_policy = static_cast<int>(CornerPolicy::NO_CUT);
+    bool m_hierarchical = false;
+    bool m_incremental = false;
+    bool m_flow_field = false;
+    int m_paint_terrain = 0;
+    int m_terrain_cost = 4;
     int m_automatic = 1;        // Muss dank ImGui int sein.
+    int m_budget_mode = static_cast<int>(BudgetMode::NODES);
+    int m_budget_nodes = 1;
+    float m_budget_milliseconds = 2.0f;
 
 
+    void camera(const glm::vec2 &offset, float zoom);
     void renderUI();
+    void renderProfiler();
 };
@@ -0,0 +1,362 @@
+#include "replanner.hpp"
+
+#include <algorithm>
+#include <array>
+
+
+static constexpr std::array DIRECTIONS = {
+        glm::ivec2(0, 1),
+        glm::ivec2(1, 0),
+        glm::ivec2(0, -1),
+        glm::ivec2(-1, 0)
+};
+
+
+static constexpr unsigned int INFINITE = CostTable::UNREACHED;
+
+
+Replanner::Replanner(Grid &grid):
+    m_grid(grid)
+{
+    m_grid.listen(this);
+}
+
+
+Replanner::~Replanner()
+{
+    m_grid.unlisten(this);
+}
+
+
+void Replanner::begin(const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    m_start = start;
+    m_goal = goal;
+    m_restart = true;
+
+    clearChanged();
+}
+
+
+void Replanner::start(const glm::ivec2 &start)
+{
+    m_start = start;
+}
+
+
+PathResult Replanner::plan()
+{
+    PathResult result;
+
+    if (!m_grid.contains(m_start) || !m_grid.contains(m_goal))
+    {
+        return result;
+    }
+
+    m_stats.changed_tiles = m_changed.size();
+
+    // A cheaper tile would make the scaled heuristic overestimate and an edited goal changes the root
+    // of the tree, the queued keys are useless in both cases.
+    if (m_restart || m_grid.minimumCost() < m_minimum_cost || m_changed_tiles.test(m_goal_index))
+    {
+        initialize();
+    }
+    else
+    {
+        m_start_index = m_grid.index(m_start);
+        m_key_modifier += heuristic(m_last_start, m_start);
+        m_last_start = m_start;
+
+        // A tile's outgoing edges and the edges into it from its neighbours changed, re-evaluate all their sources.
+        for (const std::uint32_t index : m_changed)
+        {
+            const glm::ivec2 position = m_grid.position(index);
+
+            if (index != m_goal_index)
+            {
+                m_rhs[index] = lookahead(index);
+                updateVertex(index);
+            }
+
+            for (const glm::ivec2 &offset : DIRECTIONS)
+            {
+                const glm::ivec2 neighbour_position = position + offset;
+                if (!m_grid.contains(neighbour_position))
+                {
+                    continue;
+                }
+
+                const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+                if (neighbour_index != m_goal_index)
+                {
+                    m_rhs[neighbour_index] = lookahead(neighbour_index);
+                    updateVertex(neighbour_index);
+                }
+            }
+        }
+    }
+
+    clearChanged();
+
+    m_stats.expanded = 0;
+    computeShortestPath();
+    m_stats.total_expanded += m_stats.expanded;
+    m_stats.plans++;
+
+    result.expanded = m_stats.expanded;
+    result.stats.expanded = m_stats.expanded;
+
+    if (m_rhs[m_start_index] == INFINITE)
+    {
+        return result;
+    }
+
+    // The start itself may be left inconsistent, but descending its neighbours' g values follows a shortest path.
+    std::uint32_t current_index = m_start_index;
+    result.path.push_back(m_start);
+
+    while (current_index != m_goal_index)
+    {
+        const glm::ivec2 current_position = m_grid.position(current_index);
+
+        std::uint32_t best_index = current_index;
+        unsigned int best_cost = INFINITE;
+
+        for (const glm::ivec2 &offset : DIRECTIONS)
+        {
+            const glm::ivec2 neighbour_position = current_position + offset;
+            if (!m_grid.contains(neighbour_position))
+            {
+                continue;
+            }
+
+            const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+            if (m_grid.blocked(neighbour_index) || m_g[neighbour_index] == INFINITE)
+            {
+                continue;
+            }
+
+            const unsigned int cost = m_grid.cost(neighbour_index) + m_g[neighbour_index];
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_index = neighbour_index;
+            }
+        }
+
+        if (best_index == current_index || result.path.size() > m_grid.tileCount()) [[unlikely]]
+        {
+            result.path.clear();
+            return result;
+        }
+
+        result.cost += m_grid.cost(best_index);
+        result.path.push_back(m_grid.position(best_index));
+        current_index = best_index;
+    }
+
+    result.found = true;
+
+    return result;
+}
+
+
+const ReplanStats &Replanner::stats() const
+{
+    return m_stats;
+}
+
+
+void Replanner::tileChanged(const glm::ivec2 &position)
+{
+    if (m_restart)
+    {
+        return;
+    }
+
+    const std::uint32_t index = m_grid.index(position);
+    if (!m_changed_tiles.test(index))
+    {
+        m_changed_tiles.set(index);
+        m_changed.push_back(index);
+    }
+}
+
+
+void Replanner::gridChanged()
+{
+    m_restart = true;
+
+    clearChanged();
+}
+
+
+unsigned int Replanner::heuristic(const glm::ivec2 &from, const glm::ivec2 &to) const
+{
+    return static_cast<unsigned int>(std::abs(from.x - to.x) + std::abs(from.y - to.y)) * m_minimum_cost;
+}
+
+
+std::uint64_t Replanner::key(const std::uint32_t index) const
+{
+    const unsigned int cost = std::min(m_g[index], m_rhs[index]);
+    if (cost == INFINITE)
+    {
+        return packKey(INFINITE, INFINITE);
+    }
+
+    return packKey(cost + heuristic(m_grid.position(index), m_start) + m_key_modifier, cost);
+}
+
+
+// Cheapest way to the goal through one of the tile's neighbours, entering a tile costs its terrain cost.
+unsigned int Replanner::lookahead(const std::uint32_t index) const
+{
+    if (m_grid.blocked(index))
+    {
+        return INFINITE;
+    }
+
+    const glm::ivec2 position = m_grid.position(index);
+    unsigned int best = INFINITE;
+
+    for (const glm::ivec2 &offset : DIRECTIONS)
+    {
+        const glm::ivec2 neighbour_position = position + offset;
+        if (!m_grid.contains(neighbour_position))
+        {
+            continue;
+        }
+
+        const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+        if (m_grid.blocked(neighbour_index) || m_g[neighbour_index] == INFINITE)
+        {
+            continue;
+        }
+
+        best = std::min(best, m_grid.cost(neighbour_index) + m_g[neighbour_index]);
+    }
+
+    return best;
+}
+
+
+void Replanner::initialize()
+{
+    m_g.assign(m_grid.tileCount(), INFINITE);
+    m_rhs.assign(m_grid.tileCount(), INFINITE);
+    m_open.resize(m_grid.tileCount());
+
+    m_start_index = m_grid.index(m_start);
+    m_goal_index = m_grid.index(m_goal);
+    m_last_start = m_start;
+    m_key_modifier = 0;
+    m_minimum_cost = m_grid.minimumCost();
+    m_restart = false;
+
+    clearChanged();
+    m_changed_tiles.resize(m_grid.tileCount());
+
+    if (!m_grid.blocked(m_goal_index))
+    {
+        m_rhs[m_goal_index] = 0;
+        m_open.push(m_goal_index, key(m_goal_index));
+    }
+}
+
+
+void Replanner::clearChanged()
+{
+    for (const std::uint32_t index : m_changed)
+    {
+        m_changed_tiles.reset(index);
+    }
+    m_changed.clear();
+}
+
+
+void Replanner::updateVertex(const std::uint32_t index)
+{
+    if (m_g[index] != m_rhs[index])
+    {
+        m_open.push(index, key(index));
+    }
+    else
+    {
+        m_open.remove(index);
+    }
+}
+
+
+void Replanner::computeShortestPath()
+{
+    while (!m_open.empty() && (m_open.topKey() < key(m_start_index) || m_rhs[m_start_index] > m_g[m_start_index]))
+    {
+        const std::uint32_t current_index = m_open.top();
+        const std::uint64_t old_key = m_open.topKey();
+        const std::uint64_t new_key = key(current_index);
+
+        if (old_key < new_key)
+        {
+            m_open.push(current_index, new_key);
+            continue;
+        }
+
+        m_stats.expanded++;
+
+        const glm::ivec2 current_position = m_grid.position(current_index);
+        const unsigned int current_cost = m_grid.cost(current_index);
+        const bool current_blocked = m_grid.blocked(current_index);
+
+        if (m_g[current_index] > m_rhs[current_index])
+        {
+            m_g[current_index] = m_rhs[current_index];
+            m_open.pop();
+
+            for (const glm::ivec2 &offset : DIRECTIONS)
+            {
+                const glm::ivec2 neighbour_position = current_position + offset;
+                if (!m_grid.contains(neighbour_position))
+                {
+                    continue;
+                }
+
+                const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+                if (neighbour_index == m_goal_index || m_grid.blocked(neighbour_index) || current_blocked)
+                {
+                    continue;
+                }
+
+                m_rhs[neighbour_index] = std::min(m_rhs[neighbour_index], current_cost + m_g[current_index]);
+                updateVertex(neighbour_index);
+            }
+        }
+        else
+        {
+            const unsigned int old_g = m_g[current_index];
+            m_g[current_index] = INFINITE;
+
+            for (const glm::ivec2 &offset : DIRECTIONS)
+            {
+                const glm::ivec2 neighbour_position = current_position + offset;
+                if (!m_grid.contains(neighbour_position))
+                {
+                    continue;
+                }
+
+                const std::uint32_t neighbour_index = m_grid.index(neighbour_position);
+                if (neighbour_index != m_goal_index && m_rhs[neighbour_index] == current_cost + old_g)
+                {
+                    m_rhs[neighbour_index] = lookahead(neighbour_index);
+                }
+                updateVertex(neighbour_index);
+            }
+
+            if (current_index != m_goal_index)
+            {
+                m_rhs[current_index] = lookahead(current_index);
+            }
+            updateVertex(current_index);
+        }
+    }
+}
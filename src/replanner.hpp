@@ -0,0 +1,80 @@
+#pragma once
+
+
+#include "bit_set.hpp"
+#include "grid.hpp"
+#include "indexed_heap.hpp"
+#include "search.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+struct ReplanStats
+{
+    // Vertices expanded by the last plan() call, the initial plan counts as a full search.
+    std::uint64_t expanded = 0;
+    std::uint64_t total_expanded = 0;
+    std::uint64_t changed_tiles = 0;
+    std::uint64_t plans = 0;
+};
+
+
+// D* Lite on a 4-connected grid. The search runs from the goal towards the start and keeps its
+// g and rhs values between plans, so edits reported by the grid only repair the part of the tree
+// they invalidate. The start may move, for example along the previous path, without a restart.
+class Replanner final : public GridListener
+{
+public:
+    explicit Replanner(Grid &grid);
+    Replanner(const Replanner &) = delete;
+    ~Replanner() override;
+
+    void operator=(const Replanner &) = delete;
+
+    void begin(const glm::ivec2 &start, const glm::ivec2 &goal);
+    void start(const glm::ivec2 &start);
+    [[nodiscard]] PathResult plan();
+
+    [[nodiscard]] const ReplanStats &stats() const;
+
+    void tileChanged(const glm::ivec2 &position) override;
+    void gridChanged() override;
+
+
+private:
+    Grid &m_grid;
+
+    glm::ivec2 m_start = {};
+    glm::ivec2 m_goal = {};
+    glm::ivec2 m_last_start = {};
+    std::uint32_t m_start_index = 0;
+    std::uint32_t m_goal_index = 0;
+
+    // Added to every key when the start moves, so the queued keys stay lower bounds without a resort.
+    unsigned int m_key_modifier = 0;
+    unsigned int m_minimum_cost = 1;
+    bool m_restart = true;
+
+    std::vector<unsigned int> m_g;
+    std::vector<unsigned int> m_rhs;
+    IndexedHeap<ASTAR_HEAP_ARITY> m_open;
+
+    // Tiles edited since the last plan, each listed once. Nothing is collected while a restart is
+    // pending, initialize() starts from the current grid anyway.
+    std::vector<std::uint32_t> m_changed;
+    BitSet m_changed_tiles;
+    ReplanStats m_stats;
+
+
+    [[nodiscard]] unsigned int heuristic(const glm::ivec2 &from, const glm::ivec2 &to) const;
+    [[nodiscard]] std::uint64_t key(std::uint32_t index) const;
+    [[nodiscard]] unsigned int lookahead(std::uint32_t index) const;
+
+    void initialize();
+    void clearChanged();
+    void updateVertex(std::uint32_t index);
+    void computeShortestPath();
+};
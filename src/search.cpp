@@ -0,0 +1,730 @@
+#include "search.hpp"
+
+#include "component_index.hpp"
+#include "grid.hpp"
+#include "jump_table.hpp"
+#include "landmarks.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <type_traits>
+
+
+static constexpr std::array DIRECTIONS = {
+        glm::ivec2(0, 1),
+        glm::ivec2(1, 0),
+        glm::ivec2(0, -1),
+        glm::ivec2(-1, 0)
+};
+
+
+static constexpr std::array DIAGONALS = {
+        glm::ivec2(1, 1),
+        glm::ivec2(1, -1),
+        glm::ivec2(-1, -1),
+        glm::ivec2(-1, 1)
+};
+
+
+[[nodiscard]] static unsigned int manhattan(const glm::ivec2 &current_position, const glm::ivec2 &goal_position)
+{
+    return std::abs(current_position.x - goal_position.x) + std::abs(current_position.y - goal_position.y);
+}
+
+
+[[nodiscard]] static glm::ivec2 sign(const glm::ivec2 &delta)
+{
+    return {(delta.x > 0) - (delta.x < 0), (delta.y > 0) - (delta.y < 0)};
+}
+
+
+Search::Search(const SearchOptions &options):
+    m_options(options)
+{
+    m_forward.bucket_queue.tieBreak(options.tie_break);
+    m_backward.bucket_queue.tieBreak(options.tie_break);
+}
+
+
+const SearchOptions &Search::options() const
+{
+    return m_options;
+}
+
+
+void Search::options(const SearchOptions &options)
+{
+    reset();
+
+    m_options = options;
+    m_forward.bucket_queue.tieBreak(options.tie_break);
+    m_backward.bucket_queue.tieBreak(options.tie_break);
+}
+
+
+void Search::begin(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    reset();
+
+    m_grid = &grid;
+    m_start = start;
+    m_goal = goal;
+
+    for (Frontier *frontier : {&m_forward, &m_backward})
+    {
+        if (frontier->cost_g_table.size() != grid.tileCount())
+        {
+            frontier->cost_g_table.resize(grid.tileCount());
+            frontier->came_from.assign(grid.tileCount(), CAME_FROM_NONE);
+            frontier->heap.resize(grid.tileCount());
+            frontier->bucket_queue.resize(grid.tileCount());
+        }
+    }
+
+    if (!grid.contains(start) || !grid.contains(goal))
+    {
+        m_state = SearchState::NO_PATH;
+        return;
+    }
+
+    // Diagonals that squeeze between two walls can join tiles the 4-connected components keep apart.
+    const bool squeeze = m_options.connectivity == Connectivity::EIGHT && m_options.corner_policy == CornerPolicy::ALLOW;
+    if (m_options.components != nullptr && !squeeze && !m_options.components->connected(start, goal))
+    {
+        m_state = SearchState::NO_PATH;
+        return;
+    }
+
+    m_start_index = grid.index(m_start);
+    m_goal_index = grid.index(m_goal);
+    m_minimum_cost = grid.minimumCost();
+    m_uniform_cost = grid.uniformCost();
+    m_state = SearchState::SEARCHING;
+
+    const bool eight = m_options.connectivity == Connectivity::EIGHT;
+    m_straight_cost = eight ? COST_STRAIGHT : 1;
+    m_diagonal_cost = eight ? COST_DIAGONAL : 1;
+
+    m_landmarks = nullptr;
+    if (!eight && m_options.landmarks != nullptr && m_options.landmarks->valid(grid))
+    {
+        m_landmarks = m_options.landmarks;
+    }
+
+    const bool bucket_queue = m_options.open_list == OpenListType::BUCKET_QUEUE;
+
+    const unsigned int start_h = heuristic(m_start, m_goal);
+    m_forward.cost_g_table.cost(m_start_index, 0);
+    m_forward.came_from[m_start_index] = CAME_FROM_NONE;
+    if (bucket_queue)
+    {
+        m_forward.bucket_queue.push(m_start_index, packKey(start_h, start_h));
+    }
+    else
+    {
+        m_forward.heap.push(m_start_index, packKey(start_h, start_h));
+    }
+
+    if (m_options.mode != SearchMode::BIDIRECTIONAL)
+    {
+        return;
+    }
+
+    if (m_start_index == m_goal_index)
+    {
+        m_meeting_cost = 0;
+        m_meeting_index = m_start_index;
+        m_state = SearchState::FOUND;
+        return;
+    }
+
+    m_backward.cost_g_table.cost(m_goal_index, 0);
+    m_backward.came_from[m_goal_index] = CAME_FROM_NONE;
+    if (bucket_queue)
+    {
+        m_backward.bucket_queue.push(m_goal_index, packKey(start_h, start_h));
+    }
+    else
+    {
+        m_backward.heap.push(m_goal_index, packKey(start_h, start_h));
+    }
+}
+
+
+void Search::reset()
+{
+    m_state = SearchState::IDLE;
+    m_meeting_cost = CostTable::UNREACHED;
+    m_meeting_index = CAME_FROM_NONE;
+
+    for (Frontier *frontier : {&m_forward, &m_backward})
+    {
+        frontier->cost_g_table.reset();
+        frontier->heap.clear();
+        frontier->heap.resetStats();
+        frontier->bucket_queue.clear();
+        frontier->bucket_queue.resetStats();
+    }
+
+    m_discovered.clear();
+    m_stats = {};
+}
+
+
+SearchState Search::step()
+{
+    if (m_state != SearchState::SEARCHING)
+    {
+        return m_state;
+    }
+
+    switch (m_options.open_list)
+    {
+        case OpenListType::BUCKET_QUEUE:
+            return dispatch<BucketQueue>();
+
+        case OpenListType::INDEXED_HEAP:
+            break;
+    }
+
+    return dispatch<IndexedHeap<ASTAR_HEAP_ARITY>>();
+}
+
+
+// The clock is only read every TIME_CHECK_INTERVAL steps, a step costs far less than reading it.
+StepProgress Search::advance(const StepBudget &budget)
+{
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::uint64_t TIME_CHECK_INTERVAL = 64;
+
+    const Clock::time_point start_time = Clock::now();
+
+    StepProgress progress;
+    progress.state = m_state;
+
+    while (progress.state == SearchState::SEARCHING)
+    {
+        if (budget.steps != 0 && progress.steps == budget.steps)
+        {
+            break;
+        }
+
+        if (budget.time != std::chrono::nanoseconds::zero() && progress.steps != 0 && progress.steps % TIME_CHECK_INTERVAL == 0 &&
+            Clock::now() - start_time >= budget.time)
+        {
+            break;
+        }
+
+        progress.state = step();
+        progress.steps++;
+    }
+
+    progress.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time);
+
+    return progress;
+}
+
+
+template <typename OpenList>
+OpenList &Search::openList(Frontier &frontier)
+{
+    if constexpr (std::is_same_v<OpenList, BucketQueue>)
+    {
+        return frontier.bucket_queue;
+    }
+    else
+    {
+        return frontier.heap;
+    }
+}
+
+
+template <typename OpenList>
+SearchState Search::dispatch()
+{
+    switch (m_options.mode)
+    {
+        case SearchMode::JPS:
+        case SearchMode::JPS_PLUS:
+            // Jump points rely on uniform 4-connected runs, weighted terrain and diagonals need plain A*.
+            if (!m_uniform_cost || m_options.connectivity == Connectivity::EIGHT)
+            {
+                break;
+            }
+            return expandJump<OpenList>();
+
+        case SearchMode::BIDIRECTIONAL:
+            return expandBidirectional<OpenList>();
+
+        case SearchMode::ASTAR:
+            break;
+    }
+
+    return expand<OpenList>();
+}
+
+
+template <typename OpenList>
+SearchState Search::expand()
+{
+    OpenList &open_list = openList<OpenList>(m_forward);
+
+    if (open_list.empty())
+    {
+        m_state = SearchState::NO_PATH;
+        return m_state;
+    }
+
+    const Grid &grid = *m_grid;
+
+    const std::uint32_t current_index = open_list.pop();
+    const unsigned int current_g = m_forward.cost_g_table.cost(current_index);
+
+    ASTAR_COUNT(m_stats.expanded++);
+
+    m_forward.cost_g_table.close(current_index);
+
+    if (current_index == m_goal_index) [[unlikely]]
+    {
+        m_state = SearchState::FOUND;
+        return m_state;
+    }
+
+    std::array<Neighbour, 8> adjacent = {};
+    const std::size_t adjacent_count = neighbours(grid.position(current_index), adjacent);
+
+    for (std::size_t i = 0; i < adjacent_count; i++)
+    {
+        const Neighbour &neighbour = adjacent[i];
+        const unsigned int new_g = current_g + neighbour.step * grid.cost(neighbour.index);
+
+        open<OpenList>(m_forward, neighbour.index, current_index, new_g, neighbour.position, m_goal);
+    }
+
+    return m_state;
+}
+
+
+template <typename OpenList>
+SearchState Search::expandJump()
+{
+    OpenList &open_list = openList<OpenList>(m_forward);
+
+    if (open_list.empty())
+    {
+        m_state = SearchState::NO_PATH;
+        return m_state;
+    }
+
+    const Grid &grid = *m_grid;
+    const JumpTable *table = nullptr;
+    if (m_options.mode == SearchMode::JPS_PLUS && m_options.jump_table != nullptr && !m_options.jump_table->dirty())
+    {
+        table = m_options.jump_table;
+    }
+
+    const std::uint32_t current_index = open_list.pop();
+    const unsigned int current_g = m_forward.cost_g_table.cost(current_index);
+
+    ASTAR_COUNT(m_stats.expanded++);
+
+    m_forward.cost_g_table.close(current_index);
+
+    if (current_index == m_goal_index) [[unlikely]]
+    {
+        m_state = SearchState::FOUND;
+        return m_state;
+    }
+
+    const glm::ivec2 current_position = grid.position(current_index);
+    const std::uint32_t parent_index = m_forward.came_from[current_index];
+
+    // Horizontal runs only turn at forced neighbours, vertical runs branch both ways at every tile.
+    std::array<glm::ivec2, 4> directions = {};
+    std::size_t direction_count = 0;
+
+    if (parent_index == CAME_FROM_NONE)
+    {
+        directions = DIRECTIONS;
+        direction_count = DIRECTIONS.size();
+    }
+    else
+    {
+        const glm::ivec2 direction = sign(current_position - grid.position(parent_index));
+
+        directions[direction_count++] = direction;
+
+        if (direction.x != 0)
+        {
+            for (const int side : {1, -1})
+            {
+                if (forcedVertical(grid, current_position, direction.x, side))
+                {
+                    directions[direction_count++] = glm::ivec2(0, side);
+                }
+            }
+        }
+        else
+        {
+            directions[direction_count++] = glm::ivec2(1, 0);
+            directions[direction_count++] = glm::ivec2(-1, 0);
+        }
+    }
+
+    for (std::size_t i = 0; i < direction_count; i++)
+    {
+        const glm::ivec2 &direction = directions[i];
+
+        const std::optional<glm::ivec2> jump_point = direction.x != 0 ?
+            jumpHorizontal(grid, table, current_position, direction.x, m_goal) :
+            jumpVertical(grid, table, current_position, direction.y, m_goal);
+
+        if (!jump_point)
+        {
+            continue;
+        }
+
+        const unsigned int distance = manhattan(current_position, *jump_point) * m_minimum_cost;
+        open<OpenList>(m_forward, grid.index(*jump_point), current_index, current_g + distance, *jump_point, m_goal);
+    }
+
+    return m_state;
+}
+
+
+template <typename OpenList>
+SearchState Search::expandBidirectional()
+{
+    OpenList &forward_list = openList<OpenList>(m_forward);
+    OpenList &backward_list = openList<OpenList>(m_backward);
+
+    if (forward_list.empty() || backward_list.empty())
+    {
+        m_state = m_meeting_cost != CostTable::UNREACHED ? SearchState::FOUND : SearchState::NO_PATH;
+        return m_state;
+    }
+
+    // Every undiscovered path has to leave both open lists, so it costs at least the larger minimum f.
+    const unsigned int bound = std::max(keyCostF(forward_list.topKey()), keyCostF(backward_list.topKey()));
+    if (bound >= m_meeting_cost)
+    {
+        m_state = SearchState::FOUND;
+        return m_state;
+    }
+
+    const bool forward = forward_list.size() <= backward_list.size();
+
+    Frontier &frontier = forward ? m_forward : m_backward;
+    const Frontier &other = forward ? m_backward : m_forward;
+    const glm::ivec2 &target = forward ? m_goal : m_start;
+    OpenList &open_list = forward ? forward_list : backward_list;
+
+    const Grid &grid = *m_grid;
+
+    const std::uint32_t current_index = open_list.pop();
+    const unsigned int current_g = frontier.cost_g_table.cost(current_index);
+
+    ASTAR_COUNT(m_stats.expanded++);
+
+    frontier.cost_g_table.close(current_index);
+
+    // The backward half walks edges in reverse, so it pays for the tile it leaves.
+    const unsigned int backward_cost = forward ? 0 : grid.cost(current_index);
+
+    std::array<Neighbour, 8> adjacent = {};
+    const std::size_t adjacent_count = neighbours(grid.position(current_index), adjacent);
+
+    for (std::size_t i = 0; i < adjacent_count; i++)
+    {
+        const Neighbour &neighbour = adjacent[i];
+        const unsigned int new_g = current_g + neighbour.step * (forward ? grid.cost(neighbour.index) : backward_cost);
+
+        if (!open<OpenList>(frontier, neighbour.index, current_index, new_g, neighbour.position, target))
+        {
+            continue;
+        }
+
+        const unsigned int other_g = other.cost_g_table.cost(neighbour.index);
+        if (other_g != CostTable::UNREACHED && new_g + other_g < m_meeting_cost)
+        {
+            m_meeting_cost = new_g + other_g;
+            m_meeting_index = neighbour.index;
+        }
+    }
+
+    return m_state;
+}
+
+
+// Octile distance when moving diagonally, scaled by the cheapest terrain so it never overestimates.
+// Landmarks only ever raise the bound, both are admissible so their maximum is as well.
+unsigned int Search::heuristic(const glm::ivec2 &position, const glm::ivec2 &target) const
+{
+    const glm::ivec2 delta = glm::abs(position - target);
+
+    if (m_options.connectivity == Connectivity::FOUR)
+    {
+        const unsigned int distance = static_cast<unsigned int>(delta.x + delta.y) * m_minimum_cost;
+        if (m_landmarks == nullptr)
+        {
+            return distance;
+        }
+
+        return std::max(distance, m_landmarks->heuristic(m_grid->index(position), m_grid->index(target)));
+    }
+
+    const auto diagonal = static_cast<unsigned int>(std::min(delta.x, delta.y));
+    const auto straight = static_cast<unsigned int>(std::max(delta.x, delta.y)) - diagonal;
+
+    return (diagonal * m_diagonal_cost + straight * m_straight_cost) * m_minimum_cost;
+}
+
+
+std::size_t Search::neighbours(const glm::ivec2 &position, std::array<Neighbour, 8> &adjacent) const
+{
+    const Grid &grid = *m_grid;
+    std::size_t count = 0;
+
+    for (const glm::ivec2 &offset : DIRECTIONS)
+    {
+        const glm::ivec2 neighbour_position = position + offset;
+
+        if (!grid.contains(neighbour_position)) [[unlikely]]
+        {
+            continue;
+        }
+
+        const std::uint32_t neighbour_index = grid.index(neighbour_position);
+        if (!grid.blocked(neighbour_index))
+        {
+            adjacent[count++] = {neighbour_index, neighbour_position, m_straight_cost};
+        }
+    }
+
+    if (m_options.connectivity == Connectivity::FOUR)
+    {
+        return count;
+    }
+
+    for (const glm::ivec2 &offset : DIAGONALS)
+    {
+        const glm::ivec2 neighbour_position = position + offset;
+
+        if (!grid.contains(neighbour_position)) [[unlikely]]
+        {
+            continue;
+        }
+
+        const std::uint32_t neighbour_index = grid.index(neighbour_position);
+        if (grid.blocked(neighbour_index))
+        {
+            continue;
+        }
+
+        // Both corner tiles lie inside the grid whenever the diagonal neighbour does.
+        const int corners_blocked =
+            grid.blocked(glm::ivec2(neighbour_position.x, position.y)) +
+            grid.blocked(glm::ivec2(position.x, neighbour_position.y));
+
+        switch (m_options.corner_policy)
+        {
+            case CornerPolicy::NO_CUT:
+                if (corners_blocked > 0)
+                {
+                    continue;
+                }
+                break;
+
+            case CornerPolicy::NO_SQUEEZE:
+                if (corners_blocked == 2)
+                {
+                    continue;
+                }
+                break;
+
+            case CornerPolicy::ALLOW:
+                break;
+        }
+
+        adjacent[count++] = {neighbour_index, neighbour_position, m_diagonal_cost};
+    }
+
+    return count;
+}
+
+
+template <typename OpenList>
+bool Search::open(Frontier &frontier, const std::uint32_t index, const std::uint32_t parent, const unsigned int cost_g, const glm::ivec2 &position, const glm::ivec2 &target)
+{
+    if (cost_g >= frontier.cost_g_table.cost(index))
+    {
+        return false;
+    }
+
+    const unsigned int cost_h = heuristic(position, target);
+
+    ASTAR_COUNT(m_stats.generated++);
+    ASTAR_COUNT(m_stats.reopened += frontier.cost_g_table.closed(index));
+
+    frontier.cost_g_table.cost(index, cost_g);
+    frontier.came_from[index] = parent;
+    openList<OpenList>(frontier).push(index, packKey(cost_g + cost_h, cost_h));
+
+    if (m_trace)
+    {
+        m_discovered.push_back(index);
+    }
+
+    return true;
+}
+
+
+SearchState Search::state() const
+{
+    return m_state;
+}
+
+
+PathResult Search::path() const
+{
+    PathResult result;
+
+    if (m_state != SearchState::FOUND)
+    {
+        return result;
+    }
+
+    if (m_options.mode == SearchMode::BIDIRECTIONAL)
+    {
+        appendChain(m_forward, m_meeting_index, result.path);
+        std::ranges::reverse(result.path);
+
+        const std::uint32_t after_meeting = m_backward.came_from[m_meeting_index];
+        if (m_meeting_index != m_goal_index && after_meeting != CAME_FROM_NONE)
+        {
+            appendChain(m_backward, after_meeting, result.path);
+        }
+
+        result.cost = m_meeting_cost;
+    }
+    else
+    {
+        appendChain(m_forward, m_goal_index, result.path);
+        std::ranges::reverse(result.path);
+
+        result.cost = m_forward.cost_g_table.cost(m_goal_index);
+    }
+
+    result.found = true;
+
+    return result;
+}
+
+
+PathResult Search::findPath(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    using Clock = std::chrono::steady_clock;
+
+    [[maybe_unused]] const Clock::time_point setup_time = instrumented() ? Clock::now() : Clock::time_point();
+    begin(grid, start, goal);
+
+    [[maybe_unused]] const Clock::time_point search_time = instrumented() ? Clock::now() : Clock::time_point();
+    // One node per step, cheap enough to count outside instrumented builds.
+    std::uint64_t expanded = 0;
+    while (m_state == SearchState::SEARCHING)
+    {
+        step();
+        expanded++;
+    }
+
+    [[maybe_unused]] const Clock::time_point path_time = instrumented() ? Clock::now() : Clock::time_point();
+    PathResult result = path();
+    result.expanded = expanded;
+
+    ASTAR_COUNT(m_stats.setup_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(search_time - setup_time).count());
+    ASTAR_COUNT(m_stats.search_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(path_time - search_time).count());
+    ASTAR_COUNT(m_stats.path_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - path_time).count());
+
+    result.stats = stats();
+
+    return result;
+}
+
+
+SearchStats Search::stats() const
+{
+    SearchStats stats = m_stats;
+
+    const bool bucket_queue = m_options.open_list == OpenListType::BUCKET_QUEUE;
+    const bool bidirectional = m_options.mode == SearchMode::BIDIRECTIONAL;
+
+    for (const Frontier *frontier : {&m_forward, &m_backward})
+    {
+        if (frontier == &m_backward && !bidirectional)
+        {
+            break;
+        }
+
+        const OpenListStats &open_list = bucket_queue ? frontier->bucket_queue.stats() : frontier->heap.stats();
+        stats.pushes += open_list.pushes;
+        stats.decreases += open_list.decreases;
+        stats.stale_pops += open_list.stale_pops;
+        stats.peak_open += open_list.peak_size;
+    }
+
+    return stats;
+}
+
+
+void Search::trace(const bool enabled)
+{
+    m_trace = enabled;
+}
+
+
+const std::vector<unsigned int> &Search::discovered() const
+{
+    return m_discovered;
+}
+
+
+void Search::clearDiscovered()
+{
+    m_discovered.clear();
+}
+
+
+// Walks the parent chain from index back to the frontier's root, filling in jump point gaps.
+void Search::appendChain(const Frontier &frontier, const std::uint32_t index, std::vector<glm::ivec2> &path) const
+{
+    std::uint32_t came_from_index = index;
+
+    while (came_from_index != CAME_FROM_NONE)
+    {
+        const glm::ivec2 position = m_grid->position(came_from_index);
+        came_from_index = frontier.came_from[came_from_index];
+
+        path.push_back(position);
+        if (came_from_index == CAME_FROM_NONE)
+        {
+            break;
+        }
+
+        const glm::ivec2 parent_position = m_grid->position(came_from_index);
+        const glm::ivec2 direction = sign(parent_position - position);
+
+        for (glm::ivec2 between = position + direction; between != parent_position; between += direction)
+        {
+            path.push_back(between);
+        }
+    }
+}
+
+
+PathResult findPath(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal)
+{
+    Search search;
+    return search.findPath(grid, start, goal);
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+
+#include "bucket_queue.hpp"
+#include "cost_table.hpp"
+#include "indexed_heap.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+
+#ifndef ASTAR_HEAP_ARITY
+#define ASTAR_HEAP_ARITY 4
+#endif
+
+
+class ComponentIndex;
+class Grid;
+class JumpTable;
+class Landmarks;
+
+
+enum class SearchState
+{
+    IDLE,
+    SEARCHING,
+    FOUND,
+    NO_PATH
+};
+
+
+enum class OpenListType
+{
+    INDEXED_HEAP,
+    BUCKET_QUEUE
+};
+
+
+enum class SearchMode
+{
+    ASTAR,
+    JPS,
+    JPS_PLUS,
+    BIDIRECTIONAL
+};
+
+
+enum class Connectivity
+{
+    FOUR,
+    EIGHT
+};
+
+
+// When a diagonal step may pass the two orthogonal tiles it touches.
+enum class CornerPolicy
+{
+    ALLOW,          // always
+    NO_SQUEEZE,     // unless both are blocked
+    NO_CUT          // only if both are clear
+};
+
+
+struct SearchOptions
+{
+    SearchMode mode = SearchMode::ASTAR;
+    OpenListType open_list = OpenListType::INDEXED_HEAP;
+    TieBreak tie_break = TieBreak::LIFO;
+
+    // JPS and JPS+ are 4-connected and search like plain A* when moving diagonally.
+    Connectivity connectivity = Connectivity::FOUR;
+    CornerPolicy corner_policy = CornerPolicy::NO_CUT;
+
+    // Required for JPS_PLUS, which falls back to plain JPS while the table is missing or dirty.
+    const JumpTable *jump_table = nullptr;
+
+    // Tightens the 4-connected heuristic with ALT bounds while the tables are valid for the searched grid.
+    const Landmarks *landmarks = nullptr;
+
+    // Rejects queries between different components before anything is expanded.
+    const ComponentIndex *components = nullptr;
+};
+
+
+// Filled only in ASTAR_INSTRUMENTATION builds. The phase timers are taken by findPath(),
+// callers driving step() themselves only get the counters.
+struct SearchStats
+{
+    std::uint64_t expanded = 0;
+    std::uint64_t generated = 0;
+    std::uint64_t reopened = 0;
+    std::uint64_t pushes = 0;
+    std::uint64_t decreases = 0;
+    std::uint64_t stale_pops = 0;
+    std::uint64_t peak_open = 0;
+
+    std::int64_t setup_ns = 0;
+    std::int64_t search_ns = 0;
+    std::int64_t path_ns = 0;
+};
+
+
+// Work one call of Search::advance() may do. A zero limit is left out, with both at zero the
+// search runs to completion.
+struct StepBudget
+{
+    std::uint64_t steps = 1;
+    std::chrono::nanoseconds time = std::chrono::nanoseconds::zero();
+};
+
+
+struct StepProgress
+{
+    SearchState state = SearchState::IDLE;
+    std::uint64_t steps = 0;
+    std::chrono::nanoseconds elapsed = std::chrono::nanoseconds::zero();
+};
+
+
+struct PathResult
+{
+    std::vector<glm::ivec2> path;
+    // 8-connected searches count COST_STRAIGHT per straight and COST_DIAGONAL per diagonal step.
+    unsigned int cost = 0;
+    bool found = false;
+    // Search steps findPath() took, each expands about one node. Counted in every build, unlike
+    // the stats.
+    std::uint64_t expanded = 0;
+
+    SearchStats stats;
+};
+
+
+class Search
+{
+public:
+    // 99 / 70 approximates the square root of two to about 7.2e-5, keeping the open list keys integral.
+    static constexpr unsigned int COST_STRAIGHT = 70;
+    static constexpr unsigned int COST_DIAGONAL = 99;
+
+
+    explicit Search(const SearchOptions &options = {});
+
+    [[nodiscard]] const SearchOptions &options() const;
+    void options(const SearchOptions &options);
+
+    void begin(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal);
+    void reset();
+    SearchState step();
+    StepProgress advance(const StepBudget &budget);
+    [[nodiscard]] SearchState state() const;
+
+    [[nodiscard]] PathResult path() const;
+    [[nodiscard]] PathResult findPath(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal);
+
+    [[nodiscard]] SearchStats stats() const;
+
+    void trace(bool enabled);
+    [[nodiscard]] const std::vector<unsigned int> &discovered() const;
+    void clearDiscovered();
+
+
+private:
+    struct Frontier
+    {
+        CostTable cost_g_table;
+        std::vector<std::uint32_t> came_from;
+
+        IndexedHeap<ASTAR_HEAP_ARITY> heap;
+        BucketQueue bucket_queue;
+    };
+
+
+    struct Neighbour
+    {
+        std::uint32_t index;
+        glm::ivec2 position;
+        unsigned int step;
+    };
+
+
+    SearchOptions m_options;
+
+    const Grid *m_grid = nullptr;
+    glm::ivec2 m_start;
+    glm::ivec2 m_goal;
+    std::uint32_t m_start_index = 0;
+    std::uint32_t m_goal_index = 0;
+
+    // Scales the Manhattan heuristic so it never overestimates on weighted terrain.
+    unsigned int m_minimum_cost = 1;
+    bool m_uniform_cost = true;
+
+    unsigned int m_straight_cost = 1;
+    unsigned int m_diagonal_cost = 1;
+
+    const Landmarks *m_landmarks = nullptr;
+
+    static constexpr std::uint32_t CAME_FROM_NONE = UINT32_MAX;
+    SearchState m_state = SearchState::IDLE;
+    bool m_trace = false;
+
+    Frontier m_forward;
+    Frontier m_backward;
+
+    // Best path found so far by the bidirectional mode and the tile where both halves meet.
+    unsigned int m_meeting_cost = CostTable::UNREACHED;
+    std::uint32_t m_meeting_index = CAME_FROM_NONE;
+
+    std::vector<unsigned int> m_discovered;
+
+    SearchStats m_stats;
+
+
+    template <typename OpenList>
+    [[nodiscard]] static OpenList &openList(Frontier &frontier);
+
+    template <typename OpenList>
+    SearchState dispatch();
+
+    template <typename OpenList>
+    SearchState expand();
+
+    template <typename OpenList>
+    SearchState expandJump();
+
+    template <typename OpenList>
+    SearchState expandBidirectional();
+
+    [[nodiscard]] unsigned int heuristic(const glm::ivec2 &position, const glm::ivec2 &target) const;
+    [[nodiscard]] std::size_t neighbours(const glm::ivec2 &position, std::array<Neighbour, 8> &adjacent) const;
+
+    template <typename OpenList>
+    bool open(Frontier &frontier, std::uint32_t index, std::uint32_t parent, unsigned int cost_g, const glm::ivec2 &position, const glm::ivec2 &target);
+
+    void appendChain(const Frontier &frontier, std::uint32_t index, std::vector<glm::ivec2> &path) const;
+};
+
+
+[[nodiscard]] PathResult findPath(const Grid &grid, const glm::ivec2 &start, const glm::ivec2 &goal);
@@ -0,0 +1,215 @@
+#include "search_worker.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+
+SearchWorker::SearchWorker(Search &search):
+    m_search(search),
+    m_queue(QUEUE_CAPACITY),
+    m_thread(&SearchWorker::work, this)
+{
+}
+
+
+SearchWorker::~SearchWorker()
+{
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_quit = true;
+        m_cancel = true;
+    }
+    m_changed.notify_all();
+
+    m_thread.join();
+}
+
+
+bool SearchWorker::grant(const StepBudget &budget)
+{
+    {
+        const std::scoped_lock lock(m_mutex);
+
+        if (m_granted)
+        {
+            return false;
+        }
+
+        m_budget = budget;
+        m_granted = true;
+        m_progress = {};
+        m_progress.state = m_search.state();
+    }
+    m_changed.notify_all();
+
+    return true;
+}
+
+
+void SearchWorker::pause()
+{
+    std::unique_lock lock(m_mutex);
+
+    m_cancel = true;
+    m_changed.wait(lock, [this] { return !m_granted; });
+    m_cancel = false;
+}
+
+
+void SearchWorker::clear()
+{
+    pause();
+
+    unsigned int index = 0;
+    while (m_queue.pop(index))
+    {
+    }
+
+    m_backlog.clear();
+    m_backlog_offset = 0;
+
+    const std::scoped_lock lock(m_mutex);
+    m_progress = {};
+    m_stats = {};
+    m_steps = 0;
+}
+
+
+bool SearchWorker::busy() const
+{
+    const std::scoped_lock lock(m_mutex);
+    return m_granted;
+}
+
+
+void SearchWorker::drain(std::vector<unsigned int> &discovered)
+{
+    // Checked first, everything an idle worker published is already queued or in the backlog.
+    const bool idle = !busy();
+
+    unsigned int index = 0;
+    while (m_queue.pop(index))
+    {
+        discovered.push_back(index);
+    }
+
+    if (idle)
+    {
+        discovered.insert(discovered.end(), m_backlog.begin() + static_cast<std::ptrdiff_t>(m_backlog_offset), m_backlog.end());
+        m_backlog.clear();
+        m_backlog_offset = 0;
+    }
+}
+
+
+StepProgress SearchWorker::progress() const
+{
+    const std::scoped_lock lock(m_mutex);
+    return m_progress;
+}
+
+
+SearchStats SearchWorker::stats() const
+{
+    const std::scoped_lock lock(m_mutex);
+    return m_stats;
+}
+
+
+std::uint64_t SearchWorker::steps() const
+{
+    const std::scoped_lock lock(m_mutex);
+    return m_steps;
+}
+
+
+void SearchWorker::work()
+{
+    std::unique_lock lock(m_mutex);
+
+    while (true)
+    {
+        m_changed.wait(lock, [this] { return m_quit || m_granted; });
+
+        if (m_quit)
+        {
+            return;
+        }
+
+        const StepBudget budget = m_budget;
+
+        lock.unlock();
+        run(budget);
+        lock.lock();
+
+        m_granted = false;
+        m_changed.notify_all();
+    }
+}
+
+
+// Works in batches so progress shows up while the budget lasts and a pause never waits long.
+void SearchWorker::run(const StepBudget &budget)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point start_time = Clock::now();
+
+    StepProgress total;
+    total.state = m_search.state();
+
+    while (total.state == SearchState::SEARCHING && !m_cancel.load(std::memory_order_relaxed))
+    {
+        StepBudget batch;
+        batch.steps = budget.steps == 0 ? BATCH_STEPS : std::min(BATCH_STEPS, budget.steps - total.steps);
+
+        const StepProgress progress = m_search.advance(batch);
+        total.state = progress.state;
+        total.steps += progress.steps;
+        total.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time);
+
+        publish();
+
+        {
+            const std::scoped_lock lock(m_mutex);
+            m_progress = total;
+            m_stats = m_search.stats();
+            m_steps += progress.steps;
+        }
+
+        if ((budget.steps != 0 && total.steps >= budget.steps) ||
+            (budget.time != std::chrono::nanoseconds::zero() && total.elapsed >= budget.time))
+        {
+            break;
+        }
+    }
+}
+
+
+// Waits for the consumer while the queue is full, unless a pause is pending. The rest then stays
+// in the backlog, the consumer collects it once the worker is idle.
+void SearchWorker::publish()
+{
+    const std::vector<unsigned int> &discovered = m_search.discovered();
+    m_backlog.insert(m_backlog.end(), discovered.begin(), discovered.end());
+    m_search.clearDiscovered();
+
+    while (m_backlog_offset < m_backlog.size())
+    {
+        if (m_queue.push(m_backlog[m_backlog_offset]))
+        {
+            m_backlog_offset++;
+        }
+        else if (m_cancel.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    m_backlog.clear();
+    m_backlog_offset = 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+
+#include "search.hpp"
+#include "spsc_queue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Steps a Search on its own thread. Every grant() lets it work through one budget, the tiles it
+// discovers reach the owning thread through a lock free queue drained once per frame. The search
+// itself may only be touched while the worker is not busy, pause() waits for that.
+class SearchWorker
+{
+public:
+    explicit SearchWorker(Search &search);
+    SearchWorker(const SearchWorker &) = delete;
+    ~SearchWorker();
+
+    void operator=(const SearchWorker &) = delete;
+
+    // Ignored while the worker is still busy with the previous budget.
+    bool grant(const StepBudget &budget);
+    // Stops after the current batch and returns once the worker is idle.
+    void pause();
+    // Drops everything published so far, the worker has to be idle.
+    void clear();
+    [[nodiscard]] bool busy() const;
+
+    // Appends the tiles discovered since the last call.
+    void drain(std::vector<unsigned int> &discovered);
+
+    // Snapshots of the last budget and the search counters, safe to read while busy.
+    [[nodiscard]] StepProgress progress() const;
+    [[nodiscard]] SearchStats stats() const;
+    // Steps taken since the last clear(), counted also without instrumentation.
+    [[nodiscard]] std::uint64_t steps() const;
+
+
+private:
+    // Steps between two publications, small enough that pause() answers within microseconds.
+    static constexpr std::uint64_t BATCH_STEPS = 256;
+    static constexpr std::size_t QUEUE_CAPACITY = 1 << 16;
+
+
+    Search &m_search;
+
+    SpscQueue<unsigned int> m_queue;
+    // Discovered tiles that did not fit into the queue yet, only touched by whoever is active.
+    std::vector<unsigned int> m_backlog;
+    std::size_t m_backlog_offset = 0;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    StepBudget m_budget;
+    bool m_granted = false;
+    bool m_quit = false;
+    std::atomic<bool> m_cancel = false;
+
+    StepProgress m_progress;
+    SearchStats m_stats;
+    std::uint64_t m_steps = 0;
+
+    std::thread m_thread;
+
+
+    void work();
+    void run(const StepBudget &budget);
+    void publish();
+};
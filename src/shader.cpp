@@ -89,3 +89,21 @@ void Shader::mat4(const std::string_view name, const glm::mat4 &mat) const
 {
     glUniformMatrix4fv(glGetUniformLocation(m_id, name.data()), 1, GL_FALSE, &mat[0][0]);
 }
+
+
+void Shader::vec4(const std::string_view name, const std::span<const glm::vec4> values) const
+{
+    glUniform4fv(glGetUniformLocation(m_id, name.data()), static_cast<GLsizei>(values.size()), &values.front()[0]);
+}
+
+
+void Shader::ivec4(const std::string_view name, const glm::ivec4 &vec) const
+{
+    glUniform4i(glGetUniformLocation(m_id, name.data()), vec.x, vec.y, vec.z, vec.w);
+}
+
+
+void Shader::scalar(const std::string_view name, const float value) const
+{
+    glUniform1f(glGetUniformLocation(m_id, name.data()), value);
+}
@@ -4,6 +4,7 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <span>
 #include <string_view>
 
 
@@ -19,6 +20,9 @@ public:
     void use() const;
 
     void mat4(std::string_view name, const glm::mat4 &mat) const;
+    void vec4(std::string_view name, std::span<const glm::vec4> values) const;
+    void ivec4(std::string_view name, const glm::ivec4 &vec) const;
+    void scalar(std::string_view name, float value) const;
 
 
 private:
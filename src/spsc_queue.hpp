@@ -0,0 +1,88 @@
+#pragma once
+
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+
+// Bounded ring for exactly one producer and one consumer thread. Each side writes only its own
+// index and caches the other one, so push and pop never lock and rarely touch the shared line.
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(const std::size_t capacity):
+        m_slots(std::bit_ceil(capacity)),
+        m_mask(m_slots.size() - 1)
+    {
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+
+    void operator=(const SpscQueue &) = delete;
+
+    [[nodiscard]] std::size_t capacity() const
+    {
+        return m_slots.size();
+    }
+
+    // Producer side, fails while the ring is full.
+    bool push(const T &value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_head_cache == m_slots.size())
+        {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+
+            if (tail - m_head_cache == m_slots.size())
+            {
+                return false;
+            }
+        }
+
+        m_slots[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer side, fails while the ring is empty.
+    bool pop(T &value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_tail_cache)
+        {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+
+            if (head == m_tail_cache)
+            {
+                return false;
+            }
+        }
+
+        value = m_slots[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+
+    std::vector<T> m_slots;
+    std::size_t m_mask;
+
+    // Written by the consumer, together with its copy of the tail.
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_head = 0;
+    std::size_t m_tail_cache = 0;
+
+    // Written by the producer, together with its copy of the head.
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_tail = 0;
+    std::size_t m_head_cache = 0;
+};
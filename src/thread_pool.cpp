@@ -0,0 +1,128 @@
+#include "thread_pool.hpp"
+
+
+ThreadPool::ThreadPool(unsigned int thread_count)
+{
+    if (thread_count == 0)
+    {
+        thread_count = 1;
+    }
+
+    for (unsigned int i = 0; i < thread_count; i++)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (unsigned int i = 0; i < thread_count; i++)
+    {
+        m_threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_stop = true;
+    }
+    m_work_available.notify_all();
+
+    for (std::thread &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+
+// Workers call this while the constructor may still be starting threads, m_workers is complete by then.
+unsigned int ThreadPool::threadCount() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+
+void ThreadPool::submit(Task task)
+{
+    const unsigned int worker = m_next_worker.fetch_add(1, std::memory_order_relaxed) % threadCount();
+
+    m_pending.fetch_add(1);
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_queued.fetch_add(1);
+    }
+    {
+        const std::scoped_lock lock(m_workers[worker]->mutex);
+        m_workers[worker]->tasks.push_back(std::move(task));
+    }
+    m_work_available.notify_one();
+}
+
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_pending.load() == 0; });
+}
+
+
+void ThreadPool::work(const unsigned int worker)
+{
+    while (true)
+    {
+        Task task;
+
+        if (take(worker, task))
+        {
+            task(worker);
+
+            if (m_pending.fetch_sub(1) == 1)
+            {
+                const std::scoped_lock lock(m_mutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(m_mutex);
+        m_work_available.wait(lock, [this] { return m_stop || m_queued.load() > 0; });
+
+        if (m_stop && m_queued.load() == 0)
+        {
+            return;
+        }
+    }
+}
+
+
+bool ThreadPool::take(const unsigned int worker, Task &task)
+{
+    const unsigned int count = threadCount();
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        Worker &victim = *m_workers[(worker + i) % count];
+        const std::scoped_lock lock(victim.mutex);
+
+        if (victim.tasks.empty())
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+
+        m_queued.fetch_sub(1);
+        return true;
+    }
+
+    return false;
+}
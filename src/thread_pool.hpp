@@ -0,0 +1,57 @@
+#pragma once
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Every worker owns a task deque. Workers pop their own work from the back
+// and steal from the front of the other deques once theirs runs dry.
+class ThreadPool
+{
+public:
+    using Task = std::function<void(unsigned int worker)>;
+
+
+    explicit ThreadPool(unsigned int thread_count = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    void operator=(const ThreadPool &) = delete;
+
+    [[nodiscard]] unsigned int threadCount() const;
+
+    void submit(Task task);
+    void wait();
+
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_idle;
+
+    std::atomic<std::size_t> m_queued = 0;
+    std::atomic<std::size_t> m_pending = 0;
+    std::atomic<unsigned int> m_next_worker = 0;
+    bool m_stop = false;
+
+
+    void work(unsigned int worker);
+    bool take(unsigned int worker, Task &task);
+};
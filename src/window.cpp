@@ -43,6 +43,7 @@ Window::Window(Project *project)
     glfwSetWindowUserPointer(m_handle, project);
     glfwSetFramebufferSizeCallback(m_handle, Project::framebufferSizeCallback);
     glfwSetKeyCallback(m_handle, Project::keyCallback);
+    glfwSetScrollCallback(m_handle, Project::scrollCallback);
     glfwSetWindowContentScaleCallback(m_handle, Project::windowContentScaleCallback);
     glfwSetWindowRefreshCallback(m_handle, Project::windowRefreshCallback);
 }